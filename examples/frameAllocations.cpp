@@ -0,0 +1,237 @@
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <sgui/Gui.h>
+#include <sgui/Resources/DefaultResources.h>
+#include <sgui/Resources/IconsFontAwesome7.h>
+#include <SFML/Graphics/RenderTexture.hpp>
+
+/**
+ * Count heap allocations of a fixed UI, frame per frame. After warm-up, beginFrame
+ * to endFrame and drawing of the gui should not allocate at all, this program
+ * returns an error if one of the measured frames did allocate.
+ *
+ * Global operator new are replaced, only allocations of the main thread
+ * are counted and only while a frame is measured.
+ */
+namespace
+{
+std::atomic <size_t> allocations = 0u;
+thread_local bool counting = false;
+
+void* allocate (const std::size_t size)
+{
+  if (counting) {
+    allocations++;
+  }
+  if (auto memory = std::malloc (size == 0 ? 1 : size)) {
+    return memory;
+  }
+  throw std::bad_alloc ();
+}
+
+void* allocate (const std::size_t size, const std::align_val_t alignment)
+{
+  if (counting) {
+    allocations++;
+  }
+  // std::aligned_alloc is not available everywhere, so memory is over-allocated
+  // and the original address is kept just before the aligned one
+  const auto align = std::max (static_cast <std::size_t> (alignment), sizeof (void*));
+  if (auto memory = std::malloc (size + align + sizeof (void*))) {
+    const auto start = reinterpret_cast <std::uintptr_t> (memory) + sizeof (void*);
+    const auto aligned = reinterpret_cast <void**> ((start + align - 1) / align * align);
+    aligned[-1] = memory;
+    return aligned;
+  }
+  throw std::bad_alloc ();
+}
+
+void deallocate (void* memory, const std::align_val_t)
+{
+  if (memory) {
+    std::free (static_cast <void**> (memory)[-1]);
+  }
+}
+} // namespace
+
+void* operator new (std::size_t size) { return allocate (size); }
+void* operator new[] (std::size_t size) { return allocate (size); }
+void* operator new (std::size_t size, std::align_val_t align) { return allocate (size, align); }
+void* operator new[] (std::size_t size, std::align_val_t align) { return allocate (size, align); }
+void operator delete (void* memory) noexcept { std::free (memory); }
+void operator delete[] (void* memory) noexcept { std::free (memory); }
+void operator delete (void* memory, std::size_t) noexcept { std::free (memory); }
+void operator delete[] (void* memory, std::size_t) noexcept { std::free (memory); }
+void operator delete (void* memory, std::align_val_t align) noexcept { deallocate (memory, align); }
+void operator delete[] (void* memory, std::align_val_t align) noexcept { deallocate (memory, align); }
+void operator delete (void* memory, std::size_t, std::align_val_t align) noexcept { deallocate (memory, align); }
+void operator delete[] (void* memory, std::size_t, std::align_val_t align) noexcept { deallocate (memory, align); }
+
+/**
+ * Allocations counted while a scope is alive
+ */
+struct CountedScope
+{
+  CountedScope () : start (allocations.load ()) { counting = true; }
+  ~CountedScope () { counting = false; }
+  size_t count () const { return allocations.load () - start; }
+  size_t start = 0u;
+};
+
+/**
+ * Widgets of the minimal demo, options are taken as views so literals cost
+ * nothing, but formatted strings are built once as they are owned by the caller
+ */
+struct MinimalScene
+{
+  MinimalScene ()
+  {
+    panel.title = fmt::format ("Main window with fontawesome |{}| !", ICON_FA_FONT_AWESOME);
+    titleSize.description = fmt::format ("Title font |{}| size", ICON_FA_FONT);
+    fontSize = fmt::format ("|{}| Normal font size", ICON_FA_PEN);
+  }
+  void run (sgui::Gui& gui)
+  {
+    if (gui.beginWindow (panel)) {
+      gui.button ("Close window");
+      gui.text ("Select font size");
+      gui.slider (title, 12u, 26u, titleSize);
+      gui.icon (ICON_FA_SQUARE_PLUS, {"Increase normal font size"});
+      gui.icon (ICON_FA_SQUARE_MINUS, {"Decrease normal font size"});
+      gui.text (fontSize);
+      gui.comboBox (combo);
+      gui.inputColor (color, {"font color"});
+      gui.endWindow ();
+    }
+  }
+  // data
+  uint32_t title = 18u;
+  sf::Color color = sf::Color::Black;
+  sgui::Panel panel = sgui::Panel ({{}, {1.f, 1.f}});
+  sgui::WidgetOptions titleSize = {};
+  std::string fontSize = "";
+  std::vector <std::string> combo = {"One", "Two", "Three", "Four"};
+};
+
+/**
+ * Panels, menu, wrapped text, inputs and plot
+ */
+struct WidgetsScene
+{
+  void run (sgui::Gui& gui)
+  {
+    if (gui.beginWindow (window)) {
+      gui.beginMenu ();
+      gui.menuItem ("File");
+      gui.menuItem ("Options");
+      gui.endMenu ();
+      gui.text (paragraph, wrapped);
+      gui.checkBox (checked, checkOptions);
+      gui.sameLine ();
+      gui.progressBar (0.42f, progressOptions);
+      gui.inputNumber (number, numberOptions, -100.f, 100.f, "value: ");
+      gui.inputText (input, {}, inputOptions);
+      gui.separation ();
+      gui.beginPanel (plotPanel);
+      gui.setPlotRange ({-3.f, 3.f}, {-1.5f, 1.5f});
+      gui.plot ([] (const float x) { return std::sin (x); });
+      gui.plot (points, 2.f, sf::Color::Red);
+      gui.endPanel ();
+      gui.endWindow ();
+    }
+  }
+  // data
+  bool checked = true;
+  float number = 12.5f;
+  std::string input = "editable text that is long enough to not be small";
+  std::string paragraph = "A long paragraph of text that does not fit in one line "
+    "and is wrapped in the window box, every frame, without any allocation.";
+  sgui::Panel window = sgui::Panel ({{0.f, 0.f}, {1.f, 1.f}});
+  sgui::Panel plotPanel = sgui::Panel ({{0.f, 0.f}, {1.f, 0.4f}}, true, false);
+  sgui::TextOptions wrapped = sgui::TextOptions (sf::Vector2f (400.f, 0.f));
+  sgui::WidgetOptions checkOptions = {"Enable the option"};
+  sgui::WidgetOptions progressOptions = {"Progress of the task"};
+  sgui::WidgetOptions numberOptions = {"A number with a label"};
+  sgui::WidgetOptions inputOptions = {"Text input"};
+  std::vector <sf::Vector2f> points = {{-2.f, -1.f}, {-1.f, 1.f}, {0.f, 0.f}, {1.f, 1.f}, {2.f, -1.f}};
+};
+
+/**
+ * Run a scene for warm-up frames then count allocations of measured frames
+ */
+template <typename Scene>
+bool measure (
+  const std::string& name,
+  Scene& scene,
+  sgui::Gui& gui,
+  sf::RenderWindow& window,
+  sf::RenderTexture& target)
+{
+  constexpr auto warmUpFrames = 10u;
+  constexpr auto measuredFrames = 100u;
+  const auto events = std::vector <sf::Event> ();
+  auto worstFrame = size_t (0);
+  auto worstDraw = size_t (0);
+  for (uint32_t frame = 0; frame < warmUpFrames + measuredFrames; frame++) {
+    gui.update (window, events);
+    auto frameAllocations = size_t (0);
+    {
+      auto counted = CountedScope ();
+      gui.beginFrame ();
+      scene.run (gui);
+      gui.endFrame ();
+      frameAllocations = counted.count ();
+    }
+    target.clear (sf::Color::White);
+    auto drawAllocations = size_t (0);
+    {
+      auto counted = CountedScope ();
+      target.draw (gui);
+      drawAllocations = counted.count ();
+    }
+    target.display ();
+    if (frame >= warmUpFrames) {
+      worstFrame = std::max (worstFrame, frameAllocations);
+      worstDraw = std::max (worstDraw, drawAllocations);
+    }
+  }
+  std::cout << name << ": at most " << worstFrame << " allocations per frame and "
+    << worstDraw << " per draw, after " << warmUpFrames << " warm-up frames" << std::endl;
+  return worstFrame == 0u && worstDraw == 0u;
+}
+
+int main()
+{
+  // Resources loading, default ones are read from one bundle
+  auto resources = sgui::DefaultResources ();
+  // Window is only used for gui initialization, scenes are drawn off-screen
+  auto window = sf::RenderWindow (sf::VideoMode ({640u, 480u}), "Frame allocations");
+  window.setVisible (false);
+  auto target = sf::RenderTexture ({640u, 480u});
+  // each scene is measured with its own gui
+  auto success = true;
+  {
+    auto gui = sgui::Gui (resources, window);
+    auto scene = MinimalScene ();
+    success = measure ("minimal", scene, gui, window, target) && success;
+  }
+  {
+    auto gui = sgui::Gui (resources, window);
+    auto scene = WidgetsScene ();
+    success = measure ("widgets", scene, gui, window, target) && success;
+  }
+  {
+    // frame memory is taken in an arena of the gui, freed at each beginFrame
+    auto gui = sgui::Gui (resources, window);
+    gui.setFrameMemory (1u << 20);
+    auto scene = WidgetsScene ();
+    success = measure ("widgets in arena", scene, gui, window, target) && success;
+    std::cout << "arena peak is " << gui.frameMemory ()->peak () << " bytes" << std::endl;
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -1,15 +1,13 @@
 #include <sgui/Gui.h>
-#include <sgui/DefaultFiles.h>
+#include <sgui/Resources/DefaultResources.h>
 #include <sgui/Resources/IconsFontAwesome7.h>
 #include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/Graphics/Image.hpp>
 
 int main()
 {
-  // Resources loading
-  auto font = sf::Font (sgui::DefaultFont);
-  auto atlas = sgui::TextureAtlas (sgui::DefaultAtlas);
-  auto texture = sf::Texture (sgui::DefaultTexture);
+  // Resources loading, default ones are read from one bundle
+  auto resources = sgui::DefaultResources ();
   // Window initialization
   auto window = sf::RenderWindow (sf::VideoMode ({640u, 480u}), "Minimal Demo");
   window.setFramerateLimit (60);
@@ -17,22 +15,25 @@ int main()
   sf::RenderTexture image ({640u, 480u});
   auto exportSuccess = false;
   // Gui initialization
-  auto gui = sgui::Gui (font, texture, atlas, window);
+  auto gui = sgui::Gui (resources, window);
   // Window settings and main loop
   auto mainPanel = sgui::Panel ({{}, { 1.f, 1.f }});
   mainPanel.title = fmt::format ("Main window with fontawesome |{}| !", ICON_FA_FONT_AWESOME);
   auto combo = std::vector <std::string> { "One", "Two", "Three", "Four" };
   auto style = sgui::Style ();
+  auto events = std::vector <sf::Event> ();
   while (window.isOpen ())
   {
-    // Inputs
+    // Inputs, all events of the frame are given at once to the gui
+    events.clear ();
     while (const std::optional event = window.pollEvent ())
     {
       if (event->is <sf::Event::Closed> ()) {
         window.close ();
       }
-      gui.update (window, event);
+      events.push_back (*event);
     }
+    gui.update (window, events);
     gui.setStyle (style);
     gui.updateTimer ();
     // Gui
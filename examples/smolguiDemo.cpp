@@ -3,7 +3,7 @@
 #include <thread>
 
 #include <sgui/Gui.h>
-#include <sgui/DefaultFiles.h>
+#include <sgui/Resources/DefaultResources.h>
 #include <sgui/Resources/Layout.h>
 #include <sgui/Resources/IconsFontAwesome7.h>
 
@@ -12,13 +12,8 @@ int main()
   /**
    * Resources loading
    */
-  // fonts
-  auto fontsData = sgui::FontHolder ();
-  fontsData.load ("normal", sgui::DefaultFont);
-  fontsData.load ("bold",   sgui::DefaultBoldFont);
-  // texture and atlas
-  auto atlas = sgui::TextureAtlas (sgui::DefaultAtlas);
-  auto texture = sf::Texture (sgui::DefaultTexture);
+  // fonts, texture and atlas, read from the default bundle
+  auto resources = sgui::DefaultResources ();
   // texts
   auto texts = sgui::TextContainer ();
   texts.loadFromFile (DemoDir"/english_demo.json", "english");
@@ -38,7 +33,7 @@ int main()
   /**
    * Gui initialization
    */
-  auto gui = sgui::Gui (fontsData.get ("normal"), texture, atlas, window);
+  auto gui = sgui::Gui (resources, window);
 
   /**
    * Load gui layout and set data
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <atomic>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace sgui
+{
+/**
+ * @brief bounded lock-free channel, items can be pushed by any number of
+ *   threads and are popped by a single consumer, usually the UI thread.
+ *   When it is full, pushed items are dropped and counted.
+ */
+template <typename Item>
+class Channel
+{
+public:
+  /**
+   * @brief allocate all cells at once, Channel is not copyable
+   * @param capacity maximum number of items waiting, rounded up to a power of 2
+   */
+  explicit Channel (const size_t capacity = 1024u);
+  Channel (const Channel&) = delete;
+  Channel& operator= (const Channel&) = delete;
+  /**
+   * @brief push an item, from any thread
+   * @return false if the channel was full and item was dropped
+   */
+  bool push (Item item);
+  /**
+   * @brief pop the oldest item, only from the consumer thread
+   * @return false if the channel was empty
+   */
+  bool pop (Item& item);
+  /**
+   * @brief get maximum number of items waiting
+   */
+  size_t capacity () const;
+  /**
+   * @brief get number of items pushed with success
+   */
+  uint64_t pushed () const;
+  /**
+   * @brief get number of items dropped because the channel was full
+   */
+  uint64_t dropped () const;
+private:
+  struct Cell {
+    std::atomic <size_t> sequence;
+    Item item;
+  };
+  size_t mMask = 0;
+  std::unique_ptr <Cell[]> mCells;
+  // producers and consumer positions are kept on their own cache line
+  alignas (64) std::atomic <size_t> mTail;
+  alignas (64) std::atomic <size_t> mHead;
+  alignas (64) std::atomic <uint64_t> mPushed;
+  std::atomic <uint64_t> mDropped;
+};
+
+/**
+ * @brief consumer of a channel, drained by the gui at each beginFrame
+ */
+class ChannelSink
+{
+public:
+  virtual ~ChannelSink () = default;
+  /**
+   * @brief consume new items of the channel
+   */
+  virtual void drain () = 0;
+};
+
+/**
+ * @brief keep the last items of a channel, for a log view or a streaming plot.
+ *   Its memory is bounded, older items are overwritten by new ones.
+ */
+template <typename Item>
+class ChannelHistory : public ChannelSink
+{
+public:
+  /**
+   * @brief bind history to a channel, channel must outlive it
+   * @param channel the consumed channel
+   * @param capacity maximum number of items kept
+   */
+  explicit ChannelHistory (Channel <Item>& channel, const size_t capacity = 256u);
+  /**
+   * @brief move new items of the channel in the history
+   */
+  void drain () override;
+  /**
+   * @brief get number of items kept
+   */
+  size_t size () const;
+  /**
+   * @brief get a kept item, 0 is the oldest one
+   */
+  const Item& at (const size_t index) const;
+  /**
+   * @brief copy kept items in order, from the oldest one
+   */
+  void copyTo (std::vector <Item>& items) const;
+  /**
+   * @brief get number of items received, it changes only with new items
+   */
+  uint64_t version () const;
+  /**
+   * @brief get number of items dropped by the channel
+   */
+  uint64_t dropped () const;
+  /**
+   * @brief get number of items overwritten in history
+   */
+  uint64_t overwritten () const;
+private:
+  Channel <Item>& mChannel;
+  std::vector <Item> mItems;
+  size_t mFirst = 0;
+  size_t mSize = 0;
+  uint64_t mReceived = 0u;
+};
+
+/**
+ * @brief keep only the last item of a channel, for a progress bar or a value
+ */
+template <typename Item>
+class ChannelLatest : public ChannelSink
+{
+public:
+  /**
+   * @brief bind to a channel, channel must outlive it
+   * @param channel the consumed channel
+   * @param initial value until an item is received
+   */
+  explicit ChannelLatest (Channel <Item>& channel, const Item& initial = {});
+  /**
+   * @brief consume new items of the channel and keep the last one
+   */
+  void drain () override;
+  /**
+   * @brief get last item received
+   */
+  const Item& value () const;
+  /**
+   * @brief get number of items received
+   */
+  uint64_t version () const;
+  /**
+   * @brief get number of items dropped by the channel
+   */
+  uint64_t dropped () const;
+private:
+  Channel <Item>& mChannel;
+  Item mValue;
+  uint64_t mReceived = 0u;
+};
+
+} // namespace sgui
+
+#include "sgui/Core/Channel.tpp"
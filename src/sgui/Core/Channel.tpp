@@ -0,0 +1,210 @@
+namespace sgui
+{
+/////////////////////////////////////////////////
+// Channel
+/////////////////////////////////////////////////
+template <typename Item>
+Channel <Item>::Channel (const size_t capacity)
+{
+  // a power of 2 capacity let us wrap positions with a mask
+  auto size = size_t (2);
+  while (size < capacity) {
+    size <<= 1;
+  }
+  mMask = size - 1;
+  mCells = std::make_unique <Cell[]> (size);
+  for (size_t index = 0; index < size; index++) {
+    mCells[index].sequence.store (index, std::memory_order_relaxed);
+  }
+  mTail.store (0, std::memory_order_relaxed);
+  mHead.store (0, std::memory_order_relaxed);
+  mPushed.store (0u, std::memory_order_relaxed);
+  mDropped.store (0u, std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+template <typename Item>
+bool Channel <Item>::push (Item item)
+{
+  auto position = mTail.load (std::memory_order_relaxed);
+  while (true) {
+    auto& cell = mCells[position & mMask];
+    const auto sequence = cell.sequence.load (std::memory_order_acquire);
+    const auto difference = static_cast <intptr_t> (sequence) - static_cast <intptr_t> (position);
+    // cell is free, try to reserve it before another producer
+    if (difference == 0) {
+      if (mTail.compare_exchange_weak (position, position + 1, std::memory_order_relaxed)) {
+        cell.item = std::move (item);
+        cell.sequence.store (position + 1, std::memory_order_release);
+        mPushed.fetch_add (1u, std::memory_order_relaxed);
+        return true;
+      }
+    // cell was not consumed yet, channel is full
+    } else if (difference < 0) {
+      mDropped.fetch_add (1u, std::memory_order_relaxed);
+      return false;
+    // another producer took the cell
+    } else {
+      position = mTail.load (std::memory_order_relaxed);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+template <typename Item>
+bool Channel <Item>::pop (Item& item)
+{
+  const auto position = mHead.load (std::memory_order_relaxed);
+  auto& cell = mCells[position & mMask];
+  const auto sequence = cell.sequence.load (std::memory_order_acquire);
+  // cell was not written yet, channel is empty
+  if (sequence != position + 1) {
+    return false;
+  }
+  item = std::move (cell.item);
+  mHead.store (position + 1, std::memory_order_relaxed);
+  cell.sequence.store (position + mMask + 1, std::memory_order_release);
+  return true;
+}
+
+/////////////////////////////////////////////////
+template <typename Item>
+size_t Channel <Item>::capacity () const
+{
+  return mMask + 1;
+}
+
+/////////////////////////////////////////////////
+template <typename Item>
+uint64_t Channel <Item>::pushed () const
+{
+  return mPushed.load (std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+template <typename Item>
+uint64_t Channel <Item>::dropped () const
+{
+  return mDropped.load (std::memory_order_relaxed);
+}
+
+
+/////////////////////////////////////////////////
+// ChannelHistory
+/////////////////////////////////////////////////
+template <typename Item>
+ChannelHistory <Item>::ChannelHistory (Channel <Item>& channel, const size_t capacity)
+  : mChannel (channel)
+{
+  mItems.resize (std::max (capacity, size_t (1)));
+}
+
+/////////////////////////////////////////////////
+template <typename Item>
+void ChannelHistory <Item>::drain ()
+{
+  // bounded by channel capacity, so fast producers cannot stall the frame
+  const auto maxItems = mChannel.capacity ();
+  for (size_t count = 0; count < maxItems; count++) {
+    auto& slot = mItems[(mFirst + mSize) % mItems.size ()];
+    if (!mChannel.pop (slot)) {
+      return;
+    }
+    mReceived++;
+    if (mSize < mItems.size ()) {
+      mSize++;
+    } else {
+      mFirst = (mFirst + 1) % mItems.size ();
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+template <typename Item>
+size_t ChannelHistory <Item>::size () const
+{
+  return mSize;
+}
+
+/////////////////////////////////////////////////
+template <typename Item>
+const Item& ChannelHistory <Item>::at (const size_t index) const
+{
+  return mItems[(mFirst + index) % mItems.size ()];
+}
+
+/////////////////////////////////////////////////
+template <typename Item>
+void ChannelHistory <Item>::copyTo (std::vector <Item>& items) const
+{
+  items.clear ();
+  for (size_t index = 0; index < mSize; index++) {
+    items.push_back (at (index));
+  }
+}
+
+/////////////////////////////////////////////////
+template <typename Item>
+uint64_t ChannelHistory <Item>::version () const
+{
+  return mReceived;
+}
+
+/////////////////////////////////////////////////
+template <typename Item>
+uint64_t ChannelHistory <Item>::dropped () const
+{
+  return mChannel.dropped ();
+}
+
+/////////////////////////////////////////////////
+template <typename Item>
+uint64_t ChannelHistory <Item>::overwritten () const
+{
+  return mReceived - mSize;
+}
+
+
+/////////////////////////////////////////////////
+// ChannelLatest
+/////////////////////////////////////////////////
+template <typename Item>
+ChannelLatest <Item>::ChannelLatest (Channel <Item>& channel, const Item& initial)
+  : mChannel (channel), mValue (initial)
+{}
+
+/////////////////////////////////////////////////
+template <typename Item>
+void ChannelLatest <Item>::drain ()
+{
+  const auto maxItems = mChannel.capacity ();
+  for (size_t count = 0; count < maxItems; count++) {
+    if (!mChannel.pop (mValue)) {
+      return;
+    }
+    mReceived++;
+  }
+}
+
+/////////////////////////////////////////////////
+template <typename Item>
+const Item& ChannelLatest <Item>::value () const
+{
+  return mValue;
+}
+
+/////////////////////////////////////////////////
+template <typename Item>
+uint64_t ChannelLatest <Item>::version () const
+{
+  return mReceived;
+}
+
+/////////////////////////////////////////////////
+template <typename Item>
+uint64_t ChannelLatest <Item>::dropped () const
+{
+  return mChannel.dropped ();
+}
+
+} // namespace sgui
@@ -0,0 +1,75 @@
+#include <algorithm>
+#include "sgui/Core/FrameArena.h"
+
+namespace sgui
+{
+/////////////////////////////////////////////////
+FrameArena::FrameArena (
+  const size_t capacity,
+  std::pmr::memory_resource* upstream)
+  : mCapacity (std::max (capacity, size_t (1))),
+    mUpstream (upstream),
+    mBuffer (upstream->allocate (mCapacity)),
+    mArena (mBuffer, mCapacity, upstream)
+{}
+
+/////////////////////////////////////////////////
+FrameArena::~FrameArena ()
+{
+  mArena.release ();
+  mUpstream->deallocate (mBuffer, mCapacity);
+}
+
+/////////////////////////////////////////////////
+void FrameArena::reset ()
+{
+  // monotonic resource goes back to the start of its initial buffer
+  mArena.release ();
+  mUsed = 0;
+}
+
+/////////////////////////////////////////////////
+size_t FrameArena::capacity () const
+{
+  return mCapacity;
+}
+
+/////////////////////////////////////////////////
+size_t FrameArena::used () const
+{
+  return mUsed;
+}
+
+/////////////////////////////////////////////////
+size_t FrameArena::peak () const
+{
+  return mPeak;
+}
+
+/////////////////////////////////////////////////
+void* FrameArena::do_allocate (
+  size_t bytes,
+  size_t alignment)
+{
+  mUsed += bytes;
+  mPeak = std::max (mPeak, mUsed);
+  return mArena.allocate (bytes, alignment);
+}
+
+/////////////////////////////////////////////////
+void FrameArena::do_deallocate (
+  void* memory,
+  size_t bytes,
+  size_t alignment)
+{
+  // memory is only freed by reset
+  mArena.deallocate (memory, bytes, alignment);
+}
+
+/////////////////////////////////////////////////
+bool FrameArena::do_is_equal (const std::pmr::memory_resource& other) const noexcept
+{
+  return this == &other;
+}
+
+} // namespace sgui
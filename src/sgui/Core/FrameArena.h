@@ -0,0 +1,71 @@
+#pragma once
+
+#include <memory>
+#include <cstddef>
+#include <memory_resource>
+
+namespace sgui
+{
+/**
+ * @brief monotonic memory resource for frame-scoped containers. Memory is
+ *   taken in a buffer allocated once from the upstream resource, and is freed
+ *   at once with reset. If a frame needs more than the buffer, extra memory is
+ *   taken from upstream until the next reset.
+ */
+class FrameArena : public std::pmr::memory_resource
+{
+public:
+  /**
+   * @brief allocate the arena buffer
+   * @param capacity is the size in bytes of the buffer
+   * @param upstream is the resource used for the buffer and extra memory
+   */
+  explicit FrameArena (
+      const size_t capacity,
+      std::pmr::memory_resource* upstream = std::pmr::get_default_resource ());
+  /**
+   * @brief give back buffer to upstream. FrameArena is not copyable.
+   */
+  ~FrameArena ();
+  FrameArena (const FrameArena&) = delete;
+  FrameArena& operator= (const FrameArena&) = delete;
+  /**
+   * @brief free every allocation at once, containers using the arena must
+   *   not hold memory anymore
+   */
+  void reset ();
+  /**
+   * @brief get size in bytes of the buffer
+   */
+  size_t capacity () const;
+  /**
+   * @brief get bytes allocated since last reset
+   */
+  size_t used () const;
+  /**
+   * @brief get maximum of bytes allocated between two resets, to size the buffer
+   */
+  size_t peak () const;
+private:
+  void* do_allocate (size_t bytes, size_t alignment) override;
+  void do_deallocate (void* memory, size_t bytes, size_t alignment) override;
+  bool do_is_equal (const std::pmr::memory_resource& other) const noexcept override;
+private:
+  size_t mCapacity = 0;
+  size_t mUsed = 0;
+  size_t mPeak = 0;
+  std::pmr::memory_resource* mUpstream = nullptr;
+  void* mBuffer = nullptr;
+  std::pmr::monotonic_buffer_resource mArena;
+};
+
+/**
+ * @brief rebuild a pmr container, empty, on another resource. Containers
+ *   keep their resource when assigned, so they are destroyed and built again.
+ */
+template <typename Container>
+void rebindResource (Container& container, std::pmr::memory_resource* resource);
+
+} // namespace sgui
+
+#include "sgui/Core/FrameArena.tpp"
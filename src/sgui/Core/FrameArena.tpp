@@ -0,0 +1,13 @@
+namespace sgui
+{
+/////////////////////////////////////////////////
+template <typename Container>
+void rebindResource (
+  Container& container,
+  std::pmr::memory_resource* resource)
+{
+  std::destroy_at (&container);
+  ::new (static_cast<void*> (&container)) Container (resource);
+}
+
+} // namespace sgui
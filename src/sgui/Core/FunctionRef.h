@@ -0,0 +1,52 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <type_traits>
+
+namespace sgui
+{
+template <typename Signature>
+class FunctionRef;
+
+/**
+ * @brief non-owning reference to a callable, as cheap to copy as two pointers.
+ *   It never allocates, and the referenced callable must outlive it.
+ */
+template <typename Return, typename... Args>
+class FunctionRef <Return (Args...)>
+{
+public:
+  /**
+   * @brief empty reference, it must not be called
+   */
+  FunctionRef () = default;
+  /**
+   * @brief reference a callable, it is not copied. A function is referenced
+   *   through its pointer, which is kept, so it can be given as a temporary.
+   */
+  template <typename Callable, typename = std::enable_if_t<
+    !std::is_same_v<std::decay_t<Callable>, FunctionRef>
+    && std::is_invocable_r_v<Return, Callable&, Args...>>>
+  FunctionRef (Callable&& callable);
+  /**
+   * @brief call referenced callable
+   */
+  Return operator() (Args... args) const;
+  /**
+   * @brief test if a callable is referenced
+   */
+  explicit operator bool () const;
+private:
+  // a function pointer can't be converted to void*, so it has its own field
+  union Storage {
+    void* object;
+    void (*function) ();
+  };
+  Storage mCallable = {nullptr};
+  Return (*mCall) (Storage, Args...) = nullptr;
+};
+
+} // namespace sgui
+
+#include "sgui/Core/FunctionRef.tpp"
@@ -0,0 +1,48 @@
+namespace sgui
+{
+/////////////////////////////////////////////////
+template <typename Return, typename... Args>
+template <typename Callable, typename>
+FunctionRef <Return (Args...)>::FunctionRef (Callable&& callable)
+{
+  using Type = std::remove_reference_t<Callable>;
+  using Decayed = std::decay_t<Callable>;
+  // functions and function pointers are referenced by the pointer itself
+  if constexpr (std::is_pointer_v<Decayed> && std::is_function_v<std::remove_pointer_t<Decayed>>) {
+    const auto function = static_cast<Decayed> (callable);
+    if (function) {
+      mCallable.function = reinterpret_cast<void (*) ()> (function);
+      mCall = [] (Storage referenced, Args... args) -> Return {
+        return reinterpret_cast<Decayed> (referenced.function) (std::forward<Args> (args)...);
+      };
+    }
+  } else {
+    mCallable.object = const_cast<void*> (static_cast<const void*> (std::addressof (callable)));
+    mCall = [] (Storage referenced, Args... args) -> Return {
+      return (*static_cast<Type*> (referenced.object)) (std::forward<Args> (args)...);
+    };
+    // an empty std::function is referenced as an empty reference
+    if constexpr (std::is_constructible_v<bool, const Type&>) {
+      if (!static_cast<bool> (callable)) {
+        mCallable.object = nullptr;
+        mCall = nullptr;
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+template <typename Return, typename... Args>
+Return FunctionRef <Return (Args...)>::operator() (Args... args) const
+{
+  return mCall (mCallable, std::forward<Args> (args)...);
+}
+
+/////////////////////////////////////////////////
+template <typename Return, typename... Args>
+FunctionRef <Return (Args...)>::operator bool () const
+{
+  return mCall != nullptr;
+}
+
+} // namespace sgui
@@ -0,0 +1,153 @@
+#include <spdlog/spdlog.h>
+#include "sgui/Core/MappedFile.h"
+
+#ifdef _WIN32
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#endif
+
+namespace sgui
+{
+/////////////////////////////////////////////////
+MappedFile::~MappedFile ()
+{
+  close ();
+}
+
+/////////////////////////////////////////////////
+MappedFile::MappedFile (MappedFile&& rhs) noexcept
+{
+  *this = std::move (rhs);
+}
+
+/////////////////////////////////////////////////
+MappedFile& MappedFile::operator= (MappedFile&& rhs) noexcept
+{
+  if (this != &rhs) {
+    close ();
+    std::swap (mOpen, rhs.mOpen);
+    std::swap (mData, rhs.mData);
+    std::swap (mSize, rhs.mSize);
+    std::swap (mFile, rhs.mFile);
+    std::swap (mMapping, rhs.mMapping);
+  }
+  return *this;
+}
+
+/////////////////////////////////////////////////
+bool MappedFile::open (const std::string& filename)
+{
+  close ();
+#ifdef _WIN32
+  const auto file = CreateFileA (filename.c_str (), GENERIC_READ, FILE_SHARE_READ,
+    nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    spdlog::error ("MappedFile::open, unable to open {}", filename);
+    return false;
+  }
+  auto fileSize = LARGE_INTEGER ();
+  GetFileSizeEx (file, &fileSize);
+  mFile = file;
+  mSize = static_cast<size_t> (fileSize.QuadPart);
+  // an empty file can't be mapped, but it's still a valid file
+  if (mSize == 0) {
+    mOpen = true;
+    return true;
+  }
+  const auto mapping = CreateFileMappingA (file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping == nullptr) {
+    spdlog::error ("MappedFile::open, unable to map {}", filename);
+    close ();
+    return false;
+  }
+  mMapping = mapping;
+  mData = static_cast<const std::byte*> (MapViewOfFile (mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+  const auto file = ::open (filename.c_str (), O_RDONLY);
+  if (file < 0) {
+    spdlog::error ("MappedFile::open, unable to open {}", filename);
+    return false;
+  }
+  struct stat status;
+  if (fstat (file, &status) != 0) {
+    spdlog::error ("MappedFile::open, unable to read size of {}", filename);
+    ::close (file);
+    return false;
+  }
+  mSize = static_cast<size_t> (status.st_size);
+  // an empty file can't be mapped, but it's still a valid file
+  if (mSize == 0) {
+    ::close (file);
+    mOpen = true;
+    return true;
+  }
+  auto* data = mmap (nullptr, mSize, PROT_READ, MAP_PRIVATE, file, 0);
+  // the mapping stay valid once the descriptor is closed
+  ::close (file);
+  if (data == MAP_FAILED) {
+    spdlog::error ("MappedFile::open, unable to map {}", filename);
+    mSize = 0;
+    return false;
+  }
+  mData = static_cast<const std::byte*> (data);
+#endif
+  if (mData == nullptr) {
+    spdlog::error ("MappedFile::open, unable to map {}", filename);
+    close ();
+    return false;
+  }
+  mOpen = true;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void MappedFile::close ()
+{
+#ifdef _WIN32
+  if (mData) {
+    UnmapViewOfFile (mData);
+  }
+  if (mMapping) {
+    CloseHandle (static_cast<HANDLE> (mMapping));
+  }
+  if (mFile) {
+    CloseHandle (static_cast<HANDLE> (mFile));
+  }
+#else
+  if (mData) {
+    munmap (const_cast<std::byte*> (mData), mSize);
+  }
+#endif
+  mOpen = false;
+  mData = nullptr;
+  mSize = 0;
+  mFile = nullptr;
+  mMapping = nullptr;
+}
+
+/////////////////////////////////////////////////
+bool MappedFile::isOpen () const
+{
+  return mOpen;
+}
+
+/////////////////////////////////////////////////
+const std::byte* MappedFile::data () const
+{
+  return mData;
+}
+
+/////////////////////////////////////////////////
+size_t MappedFile::size () const
+{
+  return mSize;
+}
+
+} // namespace sgui
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace sgui
+{
+/**
+ * @brief read-only memory mapping of a file. Pages are loaded by the os on
+ *   demand, so the file can be much bigger than the available memory.
+ */
+class MappedFile
+{
+public:
+  /**
+   * MappedFile is movable but not copyable
+   */
+  MappedFile () = default;
+  ~MappedFile ();
+  MappedFile (MappedFile&& rhs) noexcept;
+  MappedFile& operator= (MappedFile&& rhs) noexcept;
+  MappedFile (const MappedFile&) = delete;
+  MappedFile& operator= (const MappedFile&) = delete;
+  /**
+   * @brief map a file in memory
+   * @param filename is the path of the file to map
+   * @return false if the file could not be opened or mapped
+   */
+  bool open (const std::string& filename);
+  /**
+   * @brief unmap file, if any
+   */
+  void close ();
+  /**
+   * @brief test if a file is currently mapped
+   */
+  bool isOpen () const;
+  /**
+   * @brief get mapped bytes, nullptr if nothing is mapped
+   */
+  const std::byte* data () const;
+  /**
+   * @brief get size in bytes of the mapped file
+   */
+  size_t size () const;
+private:
+  bool mOpen = false;
+  const std::byte* mData = nullptr;
+  size_t mSize = 0;
+  // native handles, only used on windows
+  void* mFile = nullptr;
+  void* mMapping = nullptr;
+};
+
+} // namespace sgui
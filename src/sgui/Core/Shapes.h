@@ -2,6 +2,7 @@
 
 #include <array>
 #include <vector>
+#include <cstdint>
 #include <SFML/System/Vector2.hpp>
 
 namespace sgui
@@ -0,0 +1,63 @@
+#include "sgui/Core/ThreadPool.h"
+
+namespace sgui
+{
+/////////////////////////////////////////////////
+ThreadPool::ThreadPool (const uint32_t threadCount)
+{
+  const auto count = std::max (threadCount, 1u);
+  mWorkers.reserve (count);
+  for (uint32_t i = 0; i < count; i++) {
+    mWorkers.emplace_back ([this] () { work (); });
+  }
+}
+
+/////////////////////////////////////////////////
+ThreadPool::~ThreadPool ()
+{
+  {
+    auto lock = std::lock_guard (mMutex);
+    mStop = true;
+  }
+  mCondition.notify_all ();
+  for (auto& worker : mWorkers) {
+    worker.join ();
+  }
+}
+
+/////////////////////////////////////////////////
+uint32_t ThreadPool::size () const
+{
+  return static_cast<uint32_t> (mWorkers.size ());
+}
+
+/////////////////////////////////////////////////
+void ThreadPool::push (std::function<void ()>&& task)
+{
+  {
+    auto lock = std::lock_guard (mMutex);
+    mTasks.push (std::move (task));
+  }
+  mCondition.notify_one ();
+}
+
+/////////////////////////////////////////////////
+void ThreadPool::work ()
+{
+  while (true) {
+    auto task = std::function<void ()> ();
+    {
+      auto lock = std::unique_lock (mMutex);
+      mCondition.wait (lock, [this] () { return mStop || !mTasks.empty (); });
+      // pending tasks are still executed when stopping
+      if (mTasks.empty ()) {
+        return;
+      }
+      task = std::move (mTasks.front ());
+      mTasks.pop ();
+    }
+    task ();
+  }
+}
+
+} // namespace sgui
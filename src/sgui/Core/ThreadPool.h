@@ -0,0 +1,66 @@
+#pragma once
+
+#include <queue>
+#include <mutex>
+#include <future>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <type_traits>
+#include <condition_variable>
+
+namespace sgui
+{
+/**
+ * @brief fixed set of worker threads that execute submitted tasks in order
+ */
+class ThreadPool
+{
+public:
+  /**
+   * @brief start workers, at least one is started
+   * @param threadCount is the number of worker threads
+   */
+  explicit ThreadPool (const uint32_t threadCount = std::thread::hardware_concurrency ());
+  /**
+   * @brief finish pending tasks and join workers. ThreadPool is not copyable.
+   */
+  ~ThreadPool ();
+  ThreadPool (const ThreadPool&) = delete;
+  ThreadPool& operator= (const ThreadPool&) = delete;
+  /**
+   * @brief get number of workers
+   */
+  uint32_t size () const;
+  /**
+   * @brief queue a task
+   * @return future holding the task result
+   */
+  template <typename Task>
+  std::future<std::invoke_result_t<Task>> submit (Task&& task);
+  /**
+   * @brief call function (begin, end) on consecutive chunks of [0, count) and
+   *   wait until all chunks are processed. The calling thread takes part in the
+   *   work, so it can safely be called from a task.
+   * @param count is the number of items to process
+   * @param function is called with a chunk [begin, end)
+   * @param grain is the minimum number of items of a chunk
+   */
+  template <typename Function>
+  void parallelFor (const size_t count, const Function& function, const size_t grain = 1);
+private:
+  // loop executed by each worker
+  void work ();
+  // queue a type erased task
+  void push (std::function<void ()>&& task);
+private:
+  bool mStop = false;
+  std::mutex mMutex;
+  std::condition_variable mCondition;
+  std::queue<std::function<void ()>> mTasks;
+  std::vector<std::thread> mWorkers;
+};
+
+} // namespace sgui
+
+#include "sgui/Core/ThreadPool.tpp"
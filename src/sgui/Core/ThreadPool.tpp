@@ -0,0 +1,71 @@
+#include <memory>
+#include <atomic>
+#include <algorithm>
+
+namespace sgui
+{
+/////////////////////////////////////////////////
+template <typename Task>
+std::future<std::invoke_result_t<Task>> ThreadPool::submit (Task&& task)
+{
+  // std::function need a copyable callable, so the packaged task is shared
+  using Result = std::invoke_result_t<Task>;
+  auto packaged = std::make_shared<std::packaged_task<Result ()>> (std::forward<Task> (task));
+  auto future = packaged->get_future ();
+  push ([packaged] () { (*packaged) (); });
+  return future;
+}
+
+/////////////////////////////////////////////////
+template <typename Function>
+void ThreadPool::parallelFor (
+  const size_t count,
+  const Function& function,
+  const size_t grain)
+{
+  // split work in a few chunks per thread to balance uneven costs
+  const auto threads = static_cast<size_t> (size ()) + 1;
+  const auto chunkSize = std::max (grain, (count + 4 * threads - 1) / (4 * threads));
+  const auto chunkCount = chunkSize > 0 ? (count + chunkSize - 1) / chunkSize : 0;
+  if (chunkCount <= 1) {
+    if (count > 0) {
+      function (size_t (0), count);
+    }
+    return;
+  }
+
+  // chunks are grabbed by index, so late workers only see an exhausted counter
+  struct State {
+    std::atomic<size_t> next = 0;
+    size_t done = 0;
+    std::mutex mutex;
+    std::condition_variable finished;
+  };
+  auto state = std::make_shared<State> ();
+  const auto run = [state, count, chunkSize, chunkCount, &function] () {
+    auto processed = size_t (0);
+    for (auto chunk = state->next++; chunk < chunkCount; chunk = state->next++) {
+      const auto begin = chunk * chunkSize;
+      function (begin, std::min (begin + chunkSize, count));
+      processed++;
+    }
+    if (processed > 0) {
+      auto lock = std::lock_guard (state->mutex);
+      state->done += processed;
+      if (state->done == chunkCount) {
+        state->finished.notify_all ();
+      }
+    }
+  };
+  const auto helpers = std::min (static_cast<size_t> (size ()), chunkCount - 1);
+  for (size_t i = 0; i < helpers; i++) {
+    push (run);
+  }
+  run ();
+
+  // wait for chunks still processed by workers
+  auto lock = std::unique_lock (state->mutex);
+  state->finished.wait (lock, [&state, chunkCount] () { return state->done == chunkCount; });
+}
+
+} // namespace sgui
@@ -17,4 +17,15 @@ namespace sgui
   const std::string DefaultTexture = SguiContentsDir"/widgets.png";
   const std::string DefaultAtlas   = SguiContentsDir"/atlas.json";
 
+  /**
+   * Bundle of default contents built with the library, and its assets names.
+   * The atlas is stored in binary, it's read with a MappedTextureAtlas.
+   */
+  const std::string DefaultBundle = SguiBundleFile;
+  const std::string DefaultFontAsset        = "Luciole-Regular.ttf";
+  const std::string DefaultBoldFontAsset    = "Luciole-Bold.ttf";
+  const std::string DefaultIconsFontAsset   = "fa-7-free-Solid-900.otf";
+  const std::string DefaultTextureAsset     = "widgets.png";
+  const std::string DefaultAtlasAsset       = "atlas.sgta";
+
 } // namespace sgui
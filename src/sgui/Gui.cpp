@@ -1,4 +1,8 @@
 #include <string>
+#include <array>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
 #include <sstream>
 #include <iostream>
 #include <spdlog/spdlog.h>
@@ -6,16 +10,41 @@
 #include "sgui/Gui.h"
 #include "sgui/Resources/Layout.h"
 #include "sgui/Resources/TextContainer.h"
+#include "sgui/Resources/AssetBundle.h"
 #include "sgui/Resources/IconsFontAwesome7.h"
+#include "sgui/DefaultFiles.h"
 
 namespace sgui 
 {
+namespace
+{
+/////////////////////////////////////////////////
+// font awesome face of a gui, it's opened without copy from the default bundle
+// shared by all gui, or from contents if the bundle was not built. Each gui has
+// its own face, as sf::Font loads its glyphs lazily without synchronization.
+std::shared_ptr<const sf::Font> openFontawesome ()
+{
+  struct Icons {
+    std::shared_ptr<const AssetBundle> bundle;
+    sf::Font font;
+  };
+  auto icons = std::make_shared<Icons> ();
+  icons->bundle = defaultBundle ();
+  const auto opened = icons->bundle
+    && icons->bundle->openFont (icons->font, DefaultIconsFontAsset);
+  if (!opened && !icons->font.openFromFile (SguiContentsDir"/fa-7-free-Solid-900.otf")) {
+    spdlog::error ("Gui: unable to open font awesome");
+  }
+  return std::shared_ptr<const sf::Font> (icons, &icons->font);
+}
+} // namespace
+
 
 /////////////////////////////////////////////////
 // Initialization of Gui
 /////////////////////////////////////////////////
 Gui::Gui ()
-  : mFontawesome (SguiContentsDir"/fa-7-free-Solid-900.otf")
+  : mFontawesome (openFontawesome ())
 {}
 
 /////////////////////////////////////////////////
@@ -24,11 +53,20 @@ Gui::Gui (
   sf::Texture& textures,
   const TextureAtlas& atlas,
   const sf::RenderWindow& window)
-  : mFontawesome (SguiContentsDir"/fa-7-free-Solid-900.otf")
+  : mFontawesome (openFontawesome ())
 {
   initialize (font, textures, atlas, window);
 }
 
+/////////////////////////////////////////////////
+Gui::Gui (
+  DefaultResources& resources,
+  const sf::RenderWindow& window)
+  : mFontawesome (openFontawesome ())
+{
+  initialize (resources, window);
+}
+
 /////////////////////////////////////////////////
 void Gui::initialize (
   sf::Font& font,
@@ -43,12 +81,29 @@ void Gui::initialize (
   setView (window.getDefaultView ());
 }
 
+/////////////////////////////////////////////////
+void Gui::initialize (
+  DefaultResources& resources,
+  const sf::RenderWindow& window)
+{
+  mWindowSize = sf::Vector2f (window.getSize ());
+  setResources (resources.font (), resources.texture ());
+  if (resources.isBundled ()) {
+    setTextureAtlas (resources.mappedAtlas ());
+  } else {
+    setTextureAtlas (resources.atlas ());
+  }
+  setStyle (Style ());
+  setView (window.getDefaultView ());
+}
+
 /////////////////////////////////////////////////
 void Gui::setResources (
   sf::Font& font,
   sf::Texture& widgetTexture)
 {
   mFont = &font; 
+  mFormula.setFont (font);
   mRender.setResources (widgetTexture);
 }
 
@@ -58,6 +113,12 @@ void Gui::setTextureAtlas (const TextureAtlas& atlas)
   mRender.setTextureAtlas (atlas);
 }
 
+/////////////////////////////////////////////////
+void Gui::setTextureAtlas (const MappedTextureAtlas& atlas)
+{
+  mRender.setTextureAtlas (atlas);
+}
+
 /////////////////////////////////////////////////
 void Gui::setSounds (SoundHolder& sounds)
 {
@@ -90,6 +151,51 @@ void Gui::setPixelsPerScroll (const float amount)
   mPixelsPerScroll = amount;
 }
 
+/////////////////////////////////////////////////
+void Gui::setFrameMemory (
+  const size_t capacity,
+  std::pmr::memory_resource* upstream)
+{
+  // frame containers move to the new arena before the old one is destroyed
+  auto arena = std::make_unique <FrameArena> (capacity, upstream);
+  setFrameResource (arena.get ());
+  mFrameArena = std::move (arena);
+  mRender.clear ();
+  mPlotter.clear ();
+}
+
+/////////////////////////////////////////////////
+void Gui::unsetFrameMemory ()
+{
+  setFrameResource (std::pmr::get_default_resource ());
+  mFrameArena.reset ();
+  mRender.clear ();
+  mPlotter.clear ();
+}
+
+/////////////////////////////////////////////////
+const FrameArena* Gui::frameMemory () const
+{
+  return mFrameArena.get ();
+}
+
+/////////////////////////////////////////////////
+void Gui::bindChannel (ChannelSink& sink)
+{
+  if (std::find (mChannelSinks.begin (), mChannelSinks.end (), &sink) != mChannelSinks.end ()) {
+    spdlog::warn ("Gui::bindChannel, channel consumer is already bound");
+    return;
+  }
+  mChannelSinks.push_back (&sink);
+}
+
+/////////////////////////////////////////////////
+void Gui::unbindChannel (ChannelSink& sink)
+{
+  const auto sinks = std::remove (mChannelSinks.begin (), mChannelSinks.end (), &sink);
+  mChannelSinks.erase (sinks, mChannelSinks.end ());
+}
+
 /////////////////////////////////////////////////
 Style& Gui::style ()
 {
@@ -115,7 +221,7 @@ void Gui::setView (const sf::View& view)
 // to ease alignement
 /////////////////////////////////////////////////
 sf::Vector2f Gui::textSize (
-  const std::string& text,
+  std::string_view text,
   const TextType type) const
 {
   return mRender.textSize (text, *mFont, getFontSize (type));
@@ -279,6 +385,15 @@ sf::Vector2f Gui::textureSize (const std::string& texture) const
 /////////////////////////////////////////////////
 void Gui::beginFrame ()
 {
+  // consume items pushed by other threads since last frame
+  for (auto sink : mChannelSinks) {
+    sink->drain ();
+  }
+  // frame memory is freed at once, once no container use it
+  if (mFrameArena) {
+    setFrameResource (mFrameArena.get ());
+    mFrameArena->reset ();
+  }
   // clear all widgets
   mRender.clear ();
   mPlotter.clear ();
@@ -288,6 +403,16 @@ void Gui::beginFrame ()
   mGuiState.hoveredItem = NullID;
 }
 
+/////////////////////////////////////////////////
+void Gui::setFrameResource (std::pmr::memory_resource* resource)
+{
+  mRender.setMemoryResource (resource);
+  mPlotter.setMemoryResource (resource);
+  rebindResource (mTruncatedText, resource);
+  rebindResource (mLabelledNumber, resource);
+  rebindResource (mFormattedLines, resource);
+}
+
 /////////////////////////////////////////////////
 void Gui::endFrame (const float tooltipDelay)
 {
@@ -415,6 +540,141 @@ void Gui::update (
   mWindowSize = sf::Vector2f (window.getSize ());
 }
 
+/////////////////////////////////////////////////
+void Gui::update (
+  const sf::RenderWindow& window,
+  const sf::Event* events,
+  const size_t count)
+{
+  // reset inputs of the previous frame
+  mInputState.updated = true;
+  mInputState.mouseScrolled = false;
+  mInputState.mouseLeftReleased = false;
+  mInputState.mouseRightReleased = false;
+  mInputState.mouseMiddleReleased = false;
+  mInputState.mouseDeltaWheel = 0.f;
+  mInputState.keyIsPressed = false;
+  mInputState.textIsEntered = false;
+
+  // events left by previous frames come first
+  auto& queue = mInputState.pendingEvents;
+  queue.insert (std::end (queue), events, events + count);
+  boundInputsQueue ();
+  auto pointer = std::optional <sf::Vector2i> ();
+  const auto applied = handleInputsQueue (pointer);
+  queue.erase (std::begin (queue), std::begin (queue) + applied);
+
+  // pointer position is mapped once, from the last event that has one
+  if (pointer) {
+    mInputState.mousePosition = window.mapPixelToCoords (*pointer, window.getDefaultView ());
+  }
+  mInputState.mouseDisplacement = mInputState.mousePosition - mInputState.oldMousePosition;
+  mWindowSize = sf::Vector2f (window.getSize ());
+}
+
+/////////////////////////////////////////////////
+void Gui::update (
+  const sf::RenderWindow& window,
+  const std::vector <sf::Event>& events)
+{
+  update (window, events.data (), events.size ());
+}
+
+/////////////////////////////////////////////////
+size_t Gui::handleInputsQueue (std::optional <sf::Vector2i>& pointer)
+{
+  // a button can only change once per frame
+  auto transitions = 0u;
+  const auto transition = [this, &transitions] (const sf::Mouse::Button button, const bool down) {
+    const auto bit = 1u << static_cast <uint32_t> (button);
+    if (transitions & bit) {
+      return false;
+    }
+    transitions |= bit;
+    if (button == sf::Mouse::Button::Left) {
+      mInputState.mouseLeftDown = down;
+      mInputState.mouseLeftReleased = !down;
+    } else if (button == sf::Mouse::Button::Right) {
+      mInputState.mouseRightDown = down;
+      mInputState.mouseRightReleased = !down;
+    } else if (button == sf::Mouse::Button::Middle) {
+      mInputState.mouseMiddleDown = down;
+      mInputState.mouseMiddleReleased = !down;
+    }
+    return true;
+  };
+
+  // a press or a release pins the pointer at its position, widgets must see
+  // the click where it happened, so events elsewhere wait for the next frame
+  auto pinned = false;
+  const auto movable = [&pointer, &pinned] (const sf::Vector2i& position) {
+    return !pinned || position == *pointer;
+  };
+
+  // apply events in order, stop at the first one that can't fit in this frame
+  const auto& queue = mInputState.pendingEvents;
+  auto applied = size_t (0);
+  for (; applied < queue.size (); applied++) {
+    const auto& event = queue [applied];
+    if (const auto* moved = event.getIf <sf::Event::MouseMoved> ()) {
+      if (!movable (moved->position)) break;
+      pointer = moved->position;
+    } else if (const auto* pressed = event.getIf <sf::Event::MouseButtonPressed> ()) {
+      if (!movable (pressed->position) || !transition (pressed->button, true)) break;
+      pointer = pressed->position;
+      pinned = true;
+    } else if (const auto* released = event.getIf <sf::Event::MouseButtonReleased> ()) {
+      if (!movable (released->position) || !transition (released->button, false)) break;
+      pointer = released->position;
+      pinned = true;
+    } else if (const auto* scrolled = event.getIf <sf::Event::MouseWheelScrolled> ()) {
+      if (!movable (scrolled->position)) break;
+      mInputState.mouseDeltaWheel += scrolled->delta;
+      mInputState.mouseScrolled = mInputState.mouseScrolled
+        || scrolled->wheel == sf::Mouse::Wheel::Horizontal
+        || scrolled->wheel == sf::Mouse::Wheel::Vertical;
+      pointer = scrolled->position;
+    } else if (const auto* text = event.getIf <sf::Event::TextEntered> ()) {
+      if (mInputState.textIsEntered) break;
+      mInputState.keyPressed = text->unicode;
+      mInputState.textIsEntered = true;
+    } else if (const auto* key = event.getIf <sf::Event::KeyPressed> ()) {
+      if (mInputState.keyIsPressed) break;
+      mInputState.code = key->code;
+      mInputState.keyIsPressed = true;
+    }
+  }
+  return applied;
+}
+
+/////////////////////////////////////////////////
+void Gui::boundInputsQueue ()
+{
+  auto& queue = mInputState.pendingEvents;
+  if (queue.size () <= Impl::InputState::MaxPendingEvents) {
+    return;
+  }
+  // moves only change the pointer, only the last one is kept
+  const auto isMove = [] (const sf::Event& event) {
+    return event.is <sf::Event::MouseMoved> ();
+  };
+  const auto lastMove = std::find_if (std::rbegin (queue), std::rend (queue), isMove);
+  const auto last = static_cast <size_t> (std::distance (lastMove, std::rend (queue))) - 1;
+  auto kept = size_t (0);
+  for (size_t index = 0; index < queue.size (); index++) {
+    if (index == last || !isMove (queue [index])) {
+      queue [kept++] = queue [index];
+    }
+  }
+  queue.erase (std::begin (queue) + kept, std::end (queue));
+  // then oldest events are dropped
+  if (queue.size () > Impl::InputState::MaxPendingEvents) {
+    const auto excess = queue.size () - Impl::InputState::MaxPendingEvents;
+    spdlog::warn ("Gui::update : {} waiting events were dropped", excess);
+    queue.erase (std::begin (queue), std::begin (queue) + excess);
+  }
+}
+
 /////////////////////////////////////////////////
 void Gui::setScreenSize (const sf::Vector2f& size)
 {
@@ -456,12 +716,12 @@ void Gui::draw (
 bool Gui::beginWindow (
   Panel& settings,
   const Constraints& constraints,
-  const WidgetOptions& options)
+  const WidgetOptionsView& options)
 {
   // if window is closed skip everything
   if (settings.closed) return false;
   mChecker.begin (Impl::GroupType::Window);
-  const auto name = initializeActivable ("Window");
+  const auto& name = initializeActivable ("Window");
 
   // compute position and create a new global group
   auto windowSize = settings.size.componentWiseMul (parentGroupSize ());
@@ -601,10 +861,10 @@ void Gui::endWindow ()
 void Gui::beginPanel (
   Panel& settings,
   const Constraints& constraints,
-  const WidgetOptions& options)
+  const WidgetOptionsView& options)
 {
   mChecker.begin (Impl::GroupType::Panel);
-  const auto name = initializeActivable ("Panel");
+  const auto& name = initializeActivable ("Panel");
 
   // compute position and create a new group
   const auto position = computePosition (settings, constraints);
@@ -675,7 +935,7 @@ void Gui::beginMenu ()
 
   // assign unique id to the widget
   mChecker.begin (Impl::GroupType::Menu);
-  const auto name = initializeActivable ("MenuBar");
+  initializeActivable ("MenuBar");
 
   // construct a menu bar according to the parent size
   const auto& parent = mGroups.top ();
@@ -721,13 +981,13 @@ void Gui::endMenu ()
 /////////////////////////////////////////////////
 bool Gui::menuItem (
   const std::string& text,
-  const WidgetOptions& options)
+  const WidgetOptionsView& options)
 {
   // assign unique id to the widget
   auto& parentMenu = mGroups.top ();
   const auto itemId = parentMenu.menuItemCount;
   parentMenu.menuItemCount++;
-  const auto name = initializeActivable ("MenuItem");
+  const auto& name = initializeActivable ("MenuItem");
 
   // compute item position
   const auto itemPos = parentMenu.lastItemPosition;
@@ -786,7 +1046,9 @@ void Gui::tooltip (const float apparitionDelay)
 
     // display tooltip
     mRender.setTooltipMode ();
-    mGuiState.tooltip.display ();
+    if (mGuiState.tooltip.display) {
+      mGuiState.tooltip.display ();
+    }
     mRender.unsetTooltipMode ();
   }
 }
@@ -837,7 +1099,7 @@ void Gui::separation (const float thick)
 void Gui::image (
   const std::string& textureId,
   const sf::Vector2f& size,
-  const WidgetOptions& options)
+  const WidgetOptionsView& options)
 {
   // if size is not specified, we take the texture size by default
   const auto position = computeRelativePosition (options.displacement);
@@ -852,15 +1114,49 @@ void Gui::image (
 }
 
 
+/////////////////////////////////////////////////
+void Gui::heatmap (
+  Heatmap& map,
+  const sf::Vector2f& size,
+  const WidgetOptionsView& options)
+{
+  // if size is not specified, a cell is drawn on a pixel
+  const auto position = computeRelativePosition (options.displacement);
+  auto mapSize = size;
+  if (mapSize.lengthSquared () < 0.01f) {
+    mapSize = sf::Vector2f (map.size ());
+  }
+  // send changed cells and draw texture
+  map.update ();
+  const auto box = sf::FloatRect (position, mapSize);
+  mRender.draw (box, map.texture ());
+  updateSpacing (mapSize);
+}
+
+/////////////////////////////////////////////////
+void Gui::formula (
+  const std::string& formula,
+  const WidgetOptionsView& options)
+{
+  // formula geometry is cached, it's only moved at the widget position
+  const auto position = computeRelativePosition (options.displacement);
+  const auto& geometry = mFormula.geometry (formula, mStyle);
+  const auto offset = sgui::round (position - geometry.bounds.position);
+  for (const auto& batch : geometry.batches) {
+    mRender.draw (batch.vertices, mFont->getTexture (batch.characterSize), offset);
+  }
+  updateSpacing (geometry.bounds.size);
+}
+
 /////////////////////////////////////////////////
 // Button related widget
 /////////////////////////////////////////////////
 bool Gui::clickable (
   const sf::Vector2f& size,
-  const WidgetOptions& options)
+  const WidgetOptionsView& options)
 {
   // Initialize widget name and position
-  const auto name = initializeActivable ("Clickable");
+  const auto& name = initializeActivable ("Clickable");
   const auto position = computeRelativePosition (options.displacement);
 
   // draw widget in its state and update cursor position
@@ -880,7 +1176,7 @@ bool Gui::clickable (
 /////////////////////////////////////////////////
 bool Gui::button (
   const std::string& text,
-  const WidgetOptions& options)
+  const WidgetOptionsView& options)
 {
   // compute text position and construct a button adapted to the text
   const auto position = computeRelativePosition (options.displacement) + 1.5f*mPadding;
@@ -898,7 +1194,7 @@ bool Gui::button (
 /////////////////////////////////////////////////
 bool Gui::icon (
   const std::string& iconName,
-  const WidgetOptions& options)
+  const WidgetOptionsView& options)
 {
   // button part
   const auto size = sf::Vector2f (1.f, 1.f) * textHeight ();
@@ -916,10 +1212,10 @@ bool Gui::icon (
 /////////////////////////////////////////////////
 bool Gui::checkBox (
   bool& checked,
-  const WidgetOptions& options)
+  const WidgetOptionsView& options)
 {
   // initialize widget name and position
-  const auto name = initializeActivable ("CheckBox");
+  const auto& name = initializeActivable ("CheckBox");
   const auto position = computeRelativePosition (options.displacement);
 
   // get status of the widget,
@@ -949,9 +1245,9 @@ bool Gui::checkBox (
 // Text related widget
 /////////////////////////////////////////////////
 void Gui::text (
-  const std::string& text,
+  std::string_view text,
   const TextOptions& textOptions,
-  const WidgetOptions& options)
+  const WidgetOptionsView& options)
 {
   // compute text position
   auto position = computeRelativePosition (options.displacement);
@@ -964,7 +1260,7 @@ void Gui::text (
   if (boxSize.lengthSquared () < 0.01f) {
     boxSize = parent.box.size;
   }
-  const auto formatted = formatText (text, boxSize, textOptions.type);
+  const auto& formatted = formatText (text, boxSize, textOptions.type);
   
   // draw text and update cursor position
   auto totalTextSize = sf::Vector2f ();
@@ -989,6 +1285,25 @@ void Gui::text (
   updateSpacing (totalTextSize + mPadding);
 }
 
+/////////////////////////////////////////////////
+void Gui::logView (
+  const ChannelHistory <std::string>& log,
+  const TextOptions& textOptions,
+  const WidgetOptionsView& options)
+{
+  // description is drawn once, as a header, and options only apply to the first line
+  auto lineOptions = WidgetOptionsView (options.displacement);
+  lineOptions.tooltip = options.tooltip;
+  if (!options.description.empty ()) {
+    text (options.description, textOptions, lineOptions);
+    lineOptions = WidgetOptionsView ();
+  }
+  for (size_t line = 0; line < log.size (); line++) {
+    text (log.at (line), textOptions, lineOptions);
+    lineOptions = WidgetOptionsView ();
+  }
+}
+
 /////////////////////////////////////////////////
 void Gui::fontawesome (
   const std::string& iconName,
@@ -998,7 +1313,7 @@ void Gui::fontawesome (
   const auto shift = sf::Vector2f (0.f, 1.5f*mPadding.y);
   const auto fontSize = getFontSize (type) + 2u;
   fontawesomeIcon (position + shift, iconName, fontSize);
-  updateSpacing (mRender.textSize (iconName, mFontawesome, fontSize) + shift);
+  updateSpacing (mRender.textSize (iconName, *mFontawesome, fontSize) + shift);
 }
 
 
@@ -1008,10 +1323,10 @@ void Gui::fontawesome (
 void Gui::inputText (
   std::string& text,
   const TextOptions& textOptions,
-  const WidgetOptions& options)
+  const WidgetOptionsView& options)
 {
   // initialize widget name and position
-  const auto name = initializeActivable ("TextInput");
+  const auto& name = initializeActivable ("TextInput");
   const auto basePosition = computeRelativePosition (options.displacement);
   if (!mTextCursorPositions.has (name)) {
     mTextCursorPositions.emplace (name, text.length ());
@@ -1073,7 +1388,7 @@ void Gui::inputText (
   // take care of size normalization
   textPanel.size = normalizeSize (textPanel.size);
   mCursorPosition = box.position;
-  beginPanel (textPanel, {}, WidgetAspect {Widget::TextBox, Slices::Nine, state});
+  beginPanel (textPanel, {}, WidgetAspectView {Widget::TextBox, Slices::Nine, state});
   // remove scroller size if needed
   if (textPanel.isScrolled) {
     finalOptions.boxSize.x -= textHeight ();
@@ -1104,14 +1419,15 @@ void Gui::drawTextCursor (
   // get cursor status
   auto& textHasCursor = mTextHasCursor.get (inputTextId);
   auto cursorIndex = mTextCursorPositions.get (inputTextId);
-  const auto formattedText = formatText (text, options.boxSize, options.type);
-  // compute cursor position in text
+  const auto& formattedText = formatText (text, options.boxSize, options.type);
+  // compute cursor position in text, lines are views of the text
   for (const auto& line : formattedText) {
-    if (cursorIndex > line.length ()) {
-      cursorIndex -= line.length ();
+    const auto lineBegin = static_cast<size_t> (line.data () - text.data ());
+    if (cursorIndex > lineBegin + line.length ()) {
       position.y += textSize (line).y;
     } else {
-      position.x += textSize (line.substr (0, cursorIndex)).x;
+      const auto cursorInLine = cursorIndex > lineBegin ? cursorIndex - lineBegin : 0u;
+      position.x += textSize (line.substr (0, cursorInLine)).x;
       break;
     }
   }
@@ -1132,10 +1448,10 @@ void Gui::drawTextCursor (
 /////////////////////////////////////////////////
 void Gui::inputKey (
   char& key,
-  const WidgetOptions& options)
+  const WidgetOptionsView& options)
 {
   // initialize widget name and position
-  const auto name = initializeActivable ("KeyInput");
+  const auto& name = initializeActivable ("KeyInput");
   auto position = computeRelativePosition (options.displacement);
 
   // draw description before the box
@@ -1171,7 +1487,7 @@ void Gui::inputKey (
 /////////////////////////////////////////////////
 void Gui::inputColor (
   sf::Color& color,
-  const WidgetOptions& options)
+  const WidgetOptionsView& options)
 {
   // change color with four input number
   const auto min = std::uint8_t (0);
@@ -1199,10 +1515,10 @@ void Gui::inputColor (
 /////////////////////////////////////////////////
 void Gui::progressBar (
   const float progress,
-  const WidgetOptions& options)
+  const WidgetOptionsView& options)
 {
   // initialize widget
-  const auto name = initializeActivable ("ProgressBar");
+  const auto& name = initializeActivable ("ProgressBar");
   const auto position = computeRelativePosition (options.displacement);
 
   // draw progress bar and handle its state
@@ -1222,6 +1538,14 @@ void Gui::progressBar (
   updateSpacing ({size.x + descrSize.x, size.y});
 }
 
+/////////////////////////////////////////////////
+void Gui::progressBar (
+  const ChannelLatest <float>& progress,
+  const WidgetOptionsView& options)
+{
+  progressBar (progress.value (), options);
+}
+
 
 /////////////////////////////////////////////////
 // to plot functions in gui
@@ -1241,6 +1565,13 @@ void Gui::setSample (const uint32_t sample)
   mPlotter.setSample (sample);
 }
 
+/////////////////////////////////////////////////
+void Gui::setPlotWorkers (ThreadPool* workers)
+{
+  mPlotWorkers = workers;
+  mPlotter.setWorkers (workers);
+}
+
 /////////////////////////////////////////////////
 void Gui::setPlotBound (const sf::Vector2f& bound)
 {
@@ -1262,9 +1593,46 @@ void Gui::plot (
 {
   // cache plot data to avoid useless computation
   if (!mPlotsData.has (mCounters.plot)) {
-    cachePlotData (slope);
+    cachePlotData (slope, mPlotter.xRange);
   }
-  plot (mPlotsData.get (mCounters.plot), thickness, lineColor);
+  plotData (mPlotsData.get (mCounters.plot), thickness, lineColor);
+  mCounters.plot++;
+}
+
+/////////////////////////////////////////////////
+void Gui::plot (
+  const Parser::Expression& expression,
+  const float thickness,
+  const sf::Color& lineColor)
+{
+  if (!mPlotsData.has (mCounters.plot)) {
+    mPlotsData.emplace (mCounters.plot, Impl::PlotData ());
+  }
+  // sample formula again only if it or the sampled range changed since last sampling
+  auto& data = mPlotsData.get (mCounters.plot);
+  const auto& range = mPlotter.xRange;
+  if (data.source != expression.version ()
+    || data.range.min != range.min
+    || data.range.max != range.max
+    || data.sample != mPlotSample) {
+    // like samplePlot, points before and after the range join first and last lines
+    const auto count = static_cast<size_t> (mPlotSample) + 3;
+    const auto max = static_cast<float> (mPlotSample);
+    mExpressionX.resize (count);
+    for (size_t k = 0; k < count; k++) {
+      mExpressionX [k] = lerp (range.min, range.max, (static_cast<int> (k) - 1) / max);
+    }
+    expression.evaluate (mExpressionX, mExpressionY);
+    data.points.resize (count);
+    for (size_t k = 0; k < count; k++) {
+      data.points [k] = sf::Vector2f (mExpressionX [k], mExpressionY [k]);
+    }
+    data.version = ++mPlotDataVersion;
+    data.source = expression.version ();
+    data.range = range;
+    data.sample = mPlotSample;
+  }
+  plotData (data, thickness, lineColor);
   mCounters.plot++;
 }
 
@@ -1276,9 +1644,9 @@ void Gui::plot (
 {
   // cache plot data to avoid useless computation
   if (!mPlotsData.has (mCounters.plot)) {
-    cachePlotData (slope);
+    cachePlotData (slope, mPlotter.yRange);
   }
-  plot (mPlotsData.get (mCounters.plot), thickness, lineColor);
+  plotData (mPlotsData.get (mCounters.plot), thickness, lineColor);
   mCounters.plot++;
 }
 
@@ -1291,39 +1659,90 @@ void Gui::plot (
   // keep cursor position as handlePlotBound will modify it
   const auto position = mCursorPosition;
   handlePlotBound ();
-  mPlotter.plot (points, position, lineColor, thickness);
+  const auto cache = PlotCache (mCounters.plot, Impl::hashPoints (points));
+  mPlotter.plot (points, position, lineColor, thickness, cache);
+  mCounters.plot++;
 }
 
 /////////////////////////////////////////////////
-void Gui::forcePlotUpdate ()
+void Gui::plot (
+  const SeriesPyramid& series,
+  const float thickness,
+  const sf::Color& lineColor)
 {
-  mPlotsData.clear ();
+  // keep cursor position as handlePlotBound will modify it
+  const auto position = mCursorPosition;
+  handlePlotBound ();
+  // series is the owner of its versions, so they can't match other data
+  mPlotter.plot (series, position, lineColor, thickness, PlotCache (mCounters.plot, series.version (), &series));
+  mCounters.plot++;
 }
 
 /////////////////////////////////////////////////
-void Gui::cachePlotData (const std::function<float (float)>& slope)
+void Gui::plot (const std::vector<PlotSeries>& series)
 {
-  auto slopeData = std::vector <sf::Vector2f> ();
-  const auto max = static_cast<float> (mPlotSample);
-  for (int i = 0; i < static_cast<int> (mPlotSample); i++) {
-    const auto& range = mPlotter.xRange;
-    const auto x = sgui::lerp (range.min, range.max, i / max);
-    slopeData.emplace_back (x, slope (x));
+  // keep cursor position as handlePlotBound will modify it
+  const auto position = mCursorPosition;
+  handlePlotBound ();
+
+  // functions keep their version until forcePlotUpdate, everything else
+  // that shape the series is hashed in it
+  if (!mPlotsData.has (mCounters.plot)) {
+    auto data = Impl::PlotData ();
+    data.version = ++mPlotDataVersion;
+    mPlotsData.emplace (mCounters.plot, std::move (data));
+  }
+  auto version = mPlotsData.get (mCounters.plot).version;
+  for (const auto& curve : series) {
+    if (curve.values) {
+      version = Impl::hashValues (*curve.values, version);
+    }
+    auto thickness = uint32_t (0);
+    std::memcpy (&thickness, &curve.thickness, sizeof (thickness));
+    version = Impl::hashWord (curve.color.toInteger (), version);
+    version = Impl::hashWord (thickness, version);
   }
-  mPlotsData.emplace (mCounters.plot, std::move (slopeData));
+  version = Impl::hashWord (static_cast<uint32_t> (series.size ()), version);
+  mPlotter.plot (series, position, PlotCache (mCounters.plot, version));
+  mCounters.plot++;
 }
 
 /////////////////////////////////////////////////
-void Gui::cachePlotData (const std::function<sf::Vector2f (float)>& slope)
+void Gui::plot (
+  const ChannelHistory <sf::Vector2f>& samples,
+  const float thickness,
+  const sf::Color& lineColor)
 {
-  auto slopeData = std::vector <sf::Vector2f> ();
-  const auto max = static_cast<float> (mPlotSample);
-  for (int i = 0; i < static_cast<int> (mPlotSample); i++) {
-    const auto& range = mPlotter.yRange;
-    const auto x = sgui::lerp (range.min, range.max, i / max);
-    slopeData.emplace_back (slope (x));
+  // keep cursor position as handlePlotBound will modify it
+  const auto position = mCursorPosition;
+  handlePlotBound ();
+  // history is the owner of its versions, so they can't match other data
+  const auto cache = PlotCache (mCounters.plot, samples.version (), &samples);
+  // samples are only copied when new ones were received or settings changed
+  if (!mPlotter.loadCachedGeometry (cache, position, lineColor, thickness)) {
+    samples.copyTo (mStreamPoints);
+    mPlotter.plot (mStreamPoints, position, lineColor, thickness, cache);
   }
-  mPlotsData.emplace (mCounters.plot, std::move (slopeData));
+  mCounters.plot++;
+}
+
+/////////////////////////////////////////////////
+void Gui::forcePlotUpdate ()
+{
+  mPlotsData.clear ();
+  mPlotter.clearCache ();
+}
+
+/////////////////////////////////////////////////
+void Gui::plotData (
+  const Impl::PlotData& data,
+  const float thickness,
+  const sf::Color& lineColor)
+{
+  // keep cursor position as handlePlotBound will modify it
+  const auto position = mCursorPosition;
+  handlePlotBound ();
+  mPlotter.plot (data.points, position, lineColor, thickness, PlotCache (mCounters.plot, data.version));
 }
 
 /////////////////////////////////////////////////
@@ -1348,7 +1767,7 @@ void Gui::handlePlotBound ()
 /////////////////////////////////////////////////
 std::string Gui::comboBox (
   const std::vector <std::string>& list,
-  const WidgetOptions& options)
+  const WidgetOptionsView& options)
 {
   // if list is empty we quit and do nothing
   if (list.empty ()) return "";
@@ -1356,7 +1775,7 @@ std::string Gui::comboBox (
   // initialize widget name and position
   const auto comboBoxId = mCounters.comboBox;
   mCounters.comboBox++;
-  const auto name = initializeActivable ("ComboBox");
+  const auto& name = initializeActivable ("ComboBox");
   const auto mainBoxPosition = computeRelativePosition (options.displacement);
   mComboBoxActiveItem.emplace (comboBoxId, list.front ());
   mComboBoxClocks.emplace (comboBoxId, 0.f);
@@ -1435,7 +1854,7 @@ bool Gui::dropListItem (
   const std::string& itemName,
   const sf::Vector2f& itemSize)
 {
-  const auto name = initializeActivable ("DropListItem");
+  const auto& name = initializeActivable ("DropListItem");
 
   // get item status
   const auto box = sf::FloatRect (mCursorPosition, itemSize);
@@ -1518,7 +1937,7 @@ sf::Vector2f Gui::scroller (
   const ItemState panelState,
   const bool horizontal)
 {
-  const auto name = initializeActivable ("Scroller");
+  const auto& name = initializeActivable ("Scroller");
 
   // compute scroller position (right or bottom) and size
   auto pos = sf::Vector2f ();
@@ -1537,7 +1956,7 @@ sf::Vector2f Gui::scroller (
 
   // get scroller status, we always steal active state over the previous widget
   const auto box = sf::FloatRect (pos, size);
-  auto state = itemStatus (box, name, mInputState.mouseLeftDown, Tooltip (), true);
+  auto state = itemStatus (box, name, mInputState.mouseLeftDown, TooltipView (), true);
   mRender.draw (box, drawOptions ({Widget::Scroller, Slices::Three, state}, {}, horizontal));
 
   // if active, compute current scrolling
@@ -1792,7 +2211,7 @@ ItemState Gui::interactWithMouse (
   Panel& settings,
   const sf::FloatRect& box,
   const std::string& name,
-  const Tooltip& tooltip)
+  const TooltipView& tooltip)
 {
   // move panel according to mouse displacement
   const auto leftClick = mInputState.mouseLeftDown;
@@ -1813,7 +2232,7 @@ ItemState Gui::itemStatus (
   const sf::FloatRect& boundingBox,
   const std::string& item,
   bool condition,
-  const Tooltip& tooltip,
+  const TooltipView& tooltip,
   bool forceActive)
 {
   // if mouse does not collide with the boundingBox we are neutral
@@ -1826,7 +2245,9 @@ ItemState Gui::itemStatus (
   mGuiState.hoveredItem = item;
   if (tooltip.active) {
     mGuiState.hoveredItemBox = boundingBox;
-    mGuiState.tooltip = tooltip;
+    // tooltip is copied at each hovered frame so it stays up to date, with its
+    // callable as it is displayed after the widget call
+    tooltip.copyTo (mGuiState.tooltip);
     mGuiState.tooltip.parent = item;
   }
 
@@ -1946,40 +2367,44 @@ size_t Gui::utf8Length (const std::string& text) const
 }
 
 /////////////////////////////////////////////////
-std::string Gui::truncateText (
+std::string_view Gui::truncateText (
   const std::string& text,
   const float width) const
 {
-  auto modified = false;
-  auto truncatedText = text;
-  while (textSize (truncatedText + "...").x > width) {
-    if (textSize (truncatedText + "...").x > 2.f * width) {
-      truncatedText = truncatedText.substr (0, truncatedText.size () / 2);
+  // text is truncated in a reused buffer, with "..." at its end
+  auto length = text.size ();
+  mTruncatedText.assign (text);
+  mTruncatedText.append ("...");
+  auto textWidth = textSize (mTruncatedText).x;
+  if (textWidth <= width) {
+    return text;
+  }
+  while (textWidth > width && length > 0) {
+    if (textWidth > 2.f * width) {
+      length = length / 2;
     } else {
-      truncatedText = truncatedText.substr (0, truncatedText.size () - 1);
+      length = length - 1;
     }
-    modified = true;
-  }
-  if (modified) {
-    return truncatedText + "...";
+    mTruncatedText.replace (length, std::string::npos, "...");
+    textWidth = textSize (mTruncatedText).x;
   }
-  return text;
+  return mTruncatedText;
 }
 
 /////////////////////////////////////////////////
 void Gui::handleTextDrawing (
   const sf::Vector2f& position,
-  const std::string& text,
+  std::string_view text,
   const TextType type)
 {
   const auto fontSize = getFontSize (type);
   // searches fontawesome unicode in the string, delimited by "|" pair
-  const auto firstMarkerPos = text.find ("|");
-  if (firstMarkerPos != std::string::npos) {
-    const auto secondMarkerPos = text.find ("|", firstMarkerPos + 1);
-    if (secondMarkerPos != std::string::npos) {
+  const auto firstMarkerPos = text.find ('|');
+  if (firstMarkerPos != std::string_view::npos) {
+    const auto secondMarkerPos = text.find ('|', firstMarkerPos + 1);
+    if (secondMarkerPos != std::string_view::npos) {
       // draw first part
-      auto firstPart = std::string ("");
+      auto firstPart = std::string_view ();
       auto firstPartWidth = sf::Vector2f ();
       if (firstMarkerPos > 0) {
         firstPart = text.substr (0, firstMarkerPos);
@@ -1990,10 +2415,10 @@ void Gui::handleTextDrawing (
       const auto iconPos = position + firstPartWidth;
       const auto faIcon = text.substr (firstMarkerPos + 1, secondMarkerPos - firstMarkerPos - 1);
       fontawesomeIcon (iconPos, faIcon, fontSize);
-      const auto iconWidth = sf::Vector2f (mRender.textSize (faIcon, mFontawesome, fontSize).x, 0.f);
+      const auto iconWidth = sf::Vector2f (mRender.textSize (faIcon, *mFontawesome, fontSize).x, 0.f);
       // draw second part
       const auto secondPart = text.substr (secondMarkerPos + 1);
-      if (secondPart != "") {
+      if (!secondPart.empty ()) {
         mRender.draw (secondPart, *mFont, {sgui::round (iconPos + iconWidth), mStyle.fontColor, fontSize});
       }
       return;
@@ -2007,10 +2432,10 @@ void Gui::handleTextDrawing (
 /////////////////////////////////////////////////
 void Gui::fontawesomeIcon (
   const sf::Vector2f& position,
-  const std::string& icon,
+  std::string_view icon,
   const uint32_t fontSize)
 {
-  mRender.draw (icon, mFontawesome, {sgui::round (position), mStyle.fontColor, fontSize});
+  mRender.draw (icon, *mFontawesome, {sgui::round (position), mStyle.fontColor, fontSize});
 }
 
 /////////////////////////////////////////////////
@@ -2029,33 +2454,59 @@ uint32_t Gui::getFontSize (const TextType type) const
 }
 
 /////////////////////////////////////////////////
-std::vector<std::string> Gui::formatText (
-  const std::string& input,
+const std::pmr::vector<std::string_view>& Gui::formatText (
+  std::string_view input,
   const sf::Vector2f& boxSize,
   const TextType type) const
 {
-  auto formattedText = std::vector <std::string> ();
-  // if input is contrained by a box
-  if (boxSize.lengthSquared () > 0.01f) {
-    // read the string word by word 
-    // TODO Improves this with a less error prone code that cut the sentence char per char
-    auto in = std::istringstream (input);
-    auto word = std::string ("");
-    auto line = std::string ("");
-    while (in >> word) {
-      // add a new line if current word outpass box boundaries
-      const auto lineWidth = textSize (line + word + " ", type).x;
-      if (lineWidth >= 0.98f*boxSize.x) {
-        formattedText.emplace_back (line);
-        line = word + " ";
-      } else {
-        line += word + " ";
+  auto& formattedText = mFormattedLines;
+  formattedText.clear ();
+  // if input is not contrained by a box
+  if (boxSize.lengthSquared () <= 0.01f) {
+    formattedText.emplace_back (input);
+    return formattedText;
+  }
+  // read the string word by word, lines are views of the input and a new
+  // line character always start a new line
+  const auto isSpace = [] (const char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+  };
+  const auto noLine = std::string_view::npos;
+  auto lineBegin = noLine;
+  auto lineEnd = size_t (0);
+  auto index = size_t (0);
+  while (index < input.size ()) {
+    // skip spaces
+    if (isSpace (input [index])) {
+      if (input [index] == '\n' && lineBegin != noLine) {
+        formattedText.emplace_back (input.substr (lineBegin, lineEnd - lineBegin));
+        lineBegin = noLine;
       }
+      index++;
+      continue;
     }
-    formattedText.emplace_back (line);
-    return formattedText;
+    // read next word
+    const auto wordBegin = index;
+    while (index < input.size () && !isSpace (input [index])) {
+      index++;
+    }
+    if (lineBegin == noLine) {
+      lineBegin = wordBegin;
+      lineEnd = index;
+      continue;
+    }
+    // add a new line if current word and its space outpass box boundaries
+    const auto withWord = input.substr (lineBegin, std::min (index + 1, input.size ()) - lineBegin);
+    if (textSize (withWord, type).x >= 0.98f*boxSize.x) {
+      formattedText.emplace_back (input.substr (lineBegin, lineEnd - lineBegin));
+      lineBegin = wordBegin;
+    }
+    lineEnd = index;
+  }
+  if (lineBegin != noLine || formattedText.empty ()) {
+    lineBegin = std::min (lineBegin, lineEnd);
+    formattedText.emplace_back (input.substr (lineBegin, lineEnd - lineBegin));
   }
-  formattedText.emplace_back (input);
   return formattedText;
 }
 
@@ -2063,14 +2514,21 @@ std::vector<std::string> Gui::formatText (
 /////////////////////////////////////////////////
 // to compute automatic position of widget
 /////////////////////////////////////////////////
-std::string Gui::initializeActivable (const std::string& key)
+const std::string& Gui::initializeActivable (const std::string& key)
 {
   mCounters.widget++;
   mWidgetChain += key.front ();
   mActiveWidgetSoundId = key;
-  const auto name = key + mWidgetChain + std::to_string (mCounters.widget);
-  // use hash every where instead of string ? Not sure it is worth it...
-  // const auto hash = std::hash <std::string> {} (name);
+  // names are stored by widget count, so a fixed gui reuses their memory
+  if (mWidgetNames.size () < mCounters.widget) {
+    mWidgetNames.resize (mCounters.widget);
+  }
+  auto counter = std::array <char, 16> ();
+  const auto last = std::to_chars (counter.data (), counter.data () + counter.size (), mCounters.widget).ptr;
+  auto& name = mWidgetNames [mCounters.widget - 1];
+  name.assign (key);
+  name.append (mWidgetChain);
+  name.append (counter.data (), last);
   return name;
 }
 
@@ -2167,8 +2625,8 @@ sf::Vector2f Gui::computeRelativePosition (const sf::Vector2f& displacement) con
 
 /////////////////////////////////////////////////
 WidgetDrawOptions Gui::drawOptions (
-  const WidgetAspect& standard,
-  const WidgetAspect& custom,
+  const WidgetAspectView& standard,
+  const WidgetAspectView& custom,
   const bool horizontal,
   const float progress) const
 {
@@ -2206,17 +2664,17 @@ bool Gui::isValid (const ItemState state) const
 }
 
 /////////////////////////////////////////////////
-bool Gui::isValid (const std::string& image) const
+bool Gui::isValid (std::string_view image) const
 {
-  return image != "";
+  return !image.empty ();
 }
 
 /////////////////////////////////////////////////
 sf::Vector2f Gui::widgetDescription (
   const sf::Vector2f& position,
-  const std::string& description)
+  std::string_view description)
 {
-  if (description != "") {
+  if (!description.empty ()) {
     handleTextDrawing (position + 1.5f*mPadding, description);
     return textSize (description) + 1.5f*mPadding;
   }
@@ -1,20 +1,32 @@
 #pragma once
 
+#include <deque>
 #include <stack>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <memory_resource>
 
 #include "sgui/Widgets/Style.h"
 #include "sgui/Widgets/Panel.h"
 #include "sgui/Internals/Counters.h"
+#include "sgui/Internals/PlotData.h"
 #include "sgui/Internals/GuiGroup.h"
 #include "sgui/Internals/GuiStates.h"
 #include "sgui/Internals/ScrollerInformation.h"
 
+#include "sgui/Core/Channel.h"
 #include "sgui/Core/ObjectPool.h"
+#include "sgui/Core/FrameArena.h"
 #include "sgui/Core/Interpolation.h"
+#include "sgui/Parser/Formula.h"
+#include "sgui/Parser/Expression.h"
+#include "sgui/Render/Heatmap.h"
 #include "sgui/Render/Plotter.h"
+#include "sgui/Render/SeriesPyramid.h"
 #include "sgui/Render/GuiRender.h"
 #include "sgui/Resources/SoundPlayer.h"
+#include "sgui/Resources/DefaultResources.h"
 #include "sgui/Resources/TextContainer.h"
 
 namespace sgui 
@@ -38,6 +50,12 @@ public:
       sf::Texture& widgetTexture,
       const TextureAtlas& widgetAtlas,
       const sf::RenderWindow& window);
+  /**
+   * @brief load fontawesome and call initialize with default resources
+   */
+  Gui (
+      DefaultResources& resources,
+      const sf::RenderWindow& window);
   /**
    * @brief initialize window size and all required resources
    *   this need to be called once before beginFrame/endFrame
@@ -47,6 +65,12 @@ public:
       sf::Texture& widgetTexture,
       const TextureAtlas& widgetAtlas,
       const sf::RenderWindow& window);
+  /**
+   * @brief initialize with default resources, which must outlive the gui
+   */
+  void initialize (
+      DefaultResources& resources,
+      const sf::RenderWindow& window);
 
   ///////////////////////////////////////////////
   /**
@@ -59,6 +83,10 @@ public:
    * @brief set texture atlas
    */
   void setTextureAtlas (const TextureAtlas& widgetAtlas);
+  /**
+   * @brief set texture atlas from a binary atlas
+   */
+  void setTextureAtlas (const MappedTextureAtlas& widgetAtlas);
   /**
    * @brief this must be called once if user want to have sound effects
    */
@@ -77,6 +105,33 @@ public:
    * @brief set scroll wheel strength (should be ~ 20.f)
    */
   void setPixelsPerScroll (const float amount);
+  /**
+   * @brief use an arena of this gui for the memory of a frame : meshes, layers,
+   *   plot samples and formatted texts. It is freed at once at beginFrame, so it
+   *   must not be called between beginFrame and endFrame.
+   * @param capacity size in bytes of the arena buffer, see frameMemory ()->peak ()
+   * @param upstream resource used for the buffer and if a frame overflows it
+   */
+  void setFrameMemory (
+      const size_t capacity,
+      std::pmr::memory_resource* upstream = std::pmr::get_default_resource ());
+  /**
+   * @brief go back to frame memory kept on the heap between frames
+   */
+  void unsetFrameMemory ();
+  /**
+   * @brief get frame arena, nullptr if none is used
+   */
+  const FrameArena* frameMemory () const;
+  /**
+   * @brief drain a channel consumer at each beginFrame, so widgets bound to it
+   *   only see new items. It must stay alive until it is unbound.
+   */
+  void bindChannel (ChannelSink& sink);
+  /**
+   * @brief stop draining a channel consumer
+   */
+  void unbindChannel (ChannelSink& sink);
 
   ///////////////////////////////////////////////
   /**
@@ -84,7 +139,8 @@ public:
    */
   void setView (const sf::View& view);
   /**
-   * @brief this function must be called at the start of every loop.
+   * @brief this function must be called at the start of every loop. After warm-up,
+   *   a fixed UI doesn't allocate between beginFrame and endFrame or when drawn.
    */
   void beginFrame ();
   /**
@@ -100,6 +156,28 @@ public:
   void update (
       const sf::RenderWindow& window,
       const std::optional <sf::Event>& event);
+  /**
+   * @brief set-up inputs with all events of a frame, it should be called once
+   *   per frame, even without events. Mouse moves are merged and pointer
+   *   position is read from events. A frame sees at most one transition per
+   *   mouse button, one key and one character, later events are kept in order
+   *   for the next frames, so that quick clicks or typing are not lost. A click
+   *   is seen at its own position, moves that follow it wait for the next frame.
+   *   When too many events are waiting, moves then oldest events are dropped.
+   * @param window window on which gui is drawn.
+   * @param events events polled during the frame, in order.
+   * @param count number of events.
+   */
+  void update (
+      const sf::RenderWindow& window,
+      const sf::Event* events,
+      const size_t count);
+  /**
+   * @brief set-up inputs with all events of a frame, see above.
+   */
+  void update (
+      const sf::RenderWindow& window,
+      const std::vector <sf::Event>& events);
   /**
    * @brief set screen size, its required for panel and window 
    * to call it if no Gui::update was called
@@ -124,7 +202,7 @@ public:
    * @brief get normal size of text in gui
    */
   sf::Vector2f textSize (
-      const std::string& text,
+      std::string_view text,
       const TextType type = TextType::Normal) const;
   /**
    * @brief to have standard height size across gui code
@@ -199,7 +277,7 @@ public:
   bool beginWindow (
       Panel& settings,
       const Constraints& constraint = {},
-      const WidgetOptions& options = {});
+      const WidgetOptionsView& options = {});
   /**
    * @brief build a window using window.panel.title as a key in texts.
    * @param window contains settings, constraints and options.
@@ -222,7 +300,7 @@ public:
   void beginPanel (
       Panel& settings,
       const Constraints& constraint = {},
-      const WidgetOptions& options = {});
+      const WidgetOptionsView& options = {});
   /**
    * @brief build a panel.
    * @param window contains settings, constraints and options.
@@ -251,7 +329,7 @@ public:
    */
   bool menuItem (
       const std::string& text,
-      const WidgetOptions& options = {});
+      const WidgetOptionsView& options = {});
 
   ///////////////////////////////////////////////
   // as a general note for all widgets, displacement in options (if different from zero) 
@@ -266,40 +344,65 @@ public:
   void image (
       const std::string& textureId,
       const sf::Vector2f& size = {},
-      const WidgetOptions& options = {});
+      const WidgetOptionsView& options = {});
+  /**
+   * @brief draw a heatmap, changed cells are uploaded before drawing. The
+   *   heatmap must live until the frame is drawn.
+   * @param size of the image, grid size in pixels if not specified
+   */
+  void heatmap (
+      Heatmap& map,
+      const sf::Vector2f& size = {},
+      const WidgetOptionsView& options = {});
+  /**
+   * @brief display a mathematical formula, e.g. "#sqrt(x^2 + 1)/2". It's laid
+   *   out once per font size and color, then its glyphs are batched with the
+   *   rest of the gui.
+   */
+  void formula (
+      const std::string& formula,
+      const WidgetOptionsView& options = {});
   /**
    * @brief display a clickable button that return true if pressed
    */
   bool clickable (
       const sf::Vector2f& size,
-      const WidgetOptions& options = {});
+      const WidgetOptionsView& options = {});
   /**
    * @brief button with a text displayed over it
    */
   bool button (
       const std::string& text,
-      const WidgetOptions& options = {});
+      const WidgetOptionsView& options = {});
   /**
    * @brief clickable icon that work like a button
    */
   bool icon (
       const std::string& iconName,
-      const WidgetOptions& options = {});
+      const WidgetOptionsView& options = {});
   /**
    * @brief display textured box that can be checked
    */
   bool checkBox (
       bool& checked,
-      const WidgetOptions& options = {});
+      const WidgetOptionsView& options = {});
 
   ///////////////////////////////////////////////
   /**
    * @brief display text, if a box size is given it will be formatted to fit in
    */
   void text (
-      const std::string& text,
+      std::string_view text,
       const TextOptions& textOptions = {},
-      const WidgetOptions& options = {});
+      const WidgetOptionsView& options = {});
+  /**
+   * @brief display last lines received from a channel, from the oldest one.
+   *   Description, if any, is displayed once above them.
+   */
+  void logView (
+      const ChannelHistory <std::string>& log,
+      const TextOptions& textOptions = {},
+      const WidgetOptionsView& options = {});
   /**
    * @brief display a fontawesome icon
    */
@@ -318,10 +421,10 @@ public:
   template <typename Type>
   void inputNumber (
       Type& number,
-      const WidgetOptions& options = {},
+      const WidgetOptionsView& options = {},
       const Type min = 0,
       const Type max = 0,
-      const std::string& label = "",
+      std::string_view label = "",
       const bool fixedWidth = false);
   /**
    * @brief modify a vector2 value through text, using two inputNumber call
@@ -329,7 +432,7 @@ public:
   template <typename Type>
   void inputVector2 (
       sf::Vector2<Type>& vector,
-      const WidgetOptions& options = {},
+      const WidgetOptionsView& options = {},
       const sf::Vector2<Type>& min = {},
       const sf::Vector2<Type>& max = {});
   /**
@@ -338,7 +441,7 @@ public:
   template <typename Type>
   void inputVector3 (
       sf::Vector3<Type>& vector,
-      const WidgetOptions& options = {},
+      const WidgetOptionsView& options = {},
       const sf::Vector3<Type>& min = {},
       const sf::Vector3<Type>& max = {});
   /**
@@ -346,20 +449,20 @@ public:
    */
   void inputColor (
       sf::Color& color,
-      const WidgetOptions& options = {});
+      const WidgetOptionsView& options = {});
   /**
    * @brief modify text on one or multiple line
    */
   void inputText (
       std::string& text,
       const TextOptions& textOptions = {},
-      const WidgetOptions& options = {});
+      const WidgetOptionsView& options = {});
   /**
    * @brief modify a specific character
    */
   void inputKey (
       char& key,
-      const WidgetOptions& options = {});
+      const WidgetOptionsView& options = {});
 
   ///////////////////////////////////////////////
   /**
@@ -367,7 +470,13 @@ public:
    */
   void progressBar (
       const float progress,
-      const WidgetOptions& options = {});
+      const WidgetOptionsView& options = {});
+  /**
+   * @brief display last progress received from a channel
+   */
+  void progressBar (
+      const ChannelLatest <float>& progress,
+      const WidgetOptionsView& options = {});
 
   ///////////////////////////////////////////////
   /**
@@ -375,7 +484,7 @@ public:
    */
   std::string comboBox (
       const std::vector <std::string>& list,
-      const WidgetOptions& options = {});
+      const WidgetOptionsView& options = {});
 
   ///////////////////////////////////////////////
   /**
@@ -386,7 +495,7 @@ public:
       Type& value,
       const Type min,
       const Type max,
-      const WidgetOptions& options = {});
+      const WidgetOptionsView& options = {});
 
   ///////////////////////////////////////////////
   /**
@@ -396,6 +505,11 @@ public:
       const PlotRange xRange,
       const PlotRange yRange);
   void setSample (const uint32_t sample);
+  /**
+   * @brief set workers used to sample plotted functions, nullptr to sample
+   *   them on the calling thread. Plotted functions must then be thread safe.
+   */
+  void setPlotWorkers (ThreadPool* workers);
   /** 
    * @brief set plot size. This depend on the context of use. In a window/panel, 
    *   plot bound will be limited to the window/panel width and height. Also a
@@ -414,6 +528,26 @@ public:
       const std::function<float (float)>& slope,
       const float thickness = 1.f,
       const sf::Color& lineColor = sf::Color::White);
+  /**
+   * @brief plot a function R -> R without type erasure, so that it can be
+   *   inlined in the sampling loop. It is cached like the other functions.
+   */
+  template <typename Function,
+    typename = std::enable_if_t<std::is_invocable_r_v<float, const Function&, float>>>
+  void plot (
+      const Function& slope,
+      const float thickness = 1.f,
+      const sf::Color& lineColor = sf::Color::White);
+  /**
+   * @brief plot a compiled formula y = f(x). It's evaluated on all samples at
+   *   once and sampled again only when it's compiled again, one of its
+   *   parameters, the plot x range or the sample change, or after
+   *   forcePlotUpdate.
+   */
+  void plot (
+      const Parser::Expression& expression,
+      const float thickness = 1.f,
+      const sf::Color& lineColor = sf::Color::White);
   /**
    * @brief plot a function R -> R², i.e. a set of points. The data is cached
    *   and not recomputed until user request an update with forcePlotUpdate.
@@ -423,12 +557,36 @@ public:
       const float thickness = 1.f,
       const sf::Color& lineColor = sf::Color::White);
   /**
-   * @brief plot a set of points.
+   * @brief plot a set of points. Its geometry is cached and only regenerated
+   *   if points or plot settings change.
    */
   void plot (
       const std::vector<sf::Vector2f>& points,
       const float thickness = 1.f,
       const sf::Color& lineColor = sf::Color::White);
+  /**
+   * @brief plot a large sampled series on the current plot range. Nothing is
+   *   cached, so panning or zooming with setPlotRange is immediately visible.
+   */
+  void plot (
+      const SeriesPyramid& series,
+      const float thickness = 1.f,
+      const sf::Color& lineColor = sf::Color::White);
+  /**
+   * @brief plot several series on the same axes, x sampling and axes are
+   *   computed once for all of them. Geometry is cached, functions are only
+   *   sampled again after forcePlotUpdate or if a value series, a color, a
+   *   thickness or a plot setting change.
+   */
+  void plot (const std::vector<PlotSeries>& series);
+  /**
+   * @brief plot last points received from a channel. Its geometry is cached
+   *   until new points are received or plot settings change.
+   */
+  void plot (
+      const ChannelHistory <sf::Vector2f>& samples,
+      const float thickness = 1.f,
+      const sf::Color& lineColor = sf::Color::White);
   /**
    * @brief force cache update
    */
@@ -449,10 +607,12 @@ private:
   // this need to be called after endGroup to clean clipping layer.
   void removeClipping ();
   // move a group with the mouse if its possible
-  ItemState interactWithMouse (Panel& settings, const sf::FloatRect& box, const std::string& name, const Tooltip& info);
-  // cache plot data
-  void cachePlotData (const std::function<float (float)>& slope);
-  void cachePlotData (const std::function<sf::Vector2f (float)>& slope);
+  ItemState interactWithMouse (Panel& settings, const sf::FloatRect& box, const std::string& name, const TooltipView& info);
+  // cache plot data, each sample is evaluated once
+  template <typename Function>
+  void cachePlotData (const Function& slope, const PlotRange& range);
+  // plot cached data, its geometry is kept until data or settings change
+  void plotData (const Impl::PlotData& data, const float thickness, const sf::Color& lineColor);
   // set plot bound depending of the current context
   void handlePlotBound ();
   // for scrollable panel or window
@@ -472,7 +632,7 @@ private:
   // to manage each item in a dropList
   bool dropListItem (float& clock, const std::string& selectedName, const std::string& itemName, const sf::Vector2f& itemSize);
   // Utility function that return status of widget, it is not clickable by default
-  ItemState itemStatus (const sf::FloatRect& boundingbox, const std::string& item, const bool condition, const Tooltip& tooltip = {}, const bool forceActive = false);
+  ItemState itemStatus (const sf::FloatRect& boundingbox, const std::string& item, const bool condition, const TooltipView& tooltip = {}, const bool forceActive = false);
   // handle all edge cases and special keys
   void handleKeyInput (std::string& text, size_t& textCursorIndex);
   void drawTextCursor (sf::Vector2f position, const std::string& inputTextId, const std::string& text, const TextOptions& options);
@@ -484,27 +644,30 @@ private:
   Type convertKeyIntoNumber (std::string& key, const Type min, const Type max) const;
   template <typename Type>
   std::string formatNumberToString (const Type& number) const;
-  // format text to fit in a box
-  std::vector<std::string> formatText (const std::string& text, const sf::Vector2f& boxSize, const TextType type = TextType::Normal) const;
+  // drop frame containers and rebuild them on resource
+  void setFrameResource (std::pmr::memory_resource* resource);
+  // format text to fit in a box, lines are views of text valid until next call
+  const std::pmr::vector<std::string_view>& formatText (std::string_view text, const sf::Vector2f& boxSize, const TextType type = TextType::Normal) const;
   // get font size
   uint32_t getFontSize (const TextType type) const;
-  // fit text in a constrained line
-  std::string truncateText (const std::string& text, const float width) const;
+  // fit text in a constrained line, truncated text is valid until next call
+  std::string_view truncateText (const std::string& text, const float width) const;
   // format text for fontawesome use
-  void handleTextDrawing (const sf::Vector2f& position, const std::string& text, const TextType fontSize = TextType::Normal);
+  void handleTextDrawing (const sf::Vector2f& position, std::string_view text, const TextType fontSize = TextType::Normal);
   // draw a fontawesome icon
-  void fontawesomeIcon (const sf::Vector2f& position, const std::string& icon, const uint32_t fontSize);
-  // to compute widget name and relative position to the cursor/group
-  std::string initializeActivable (const std::string& key);
+  void fontawesomeIcon (const sf::Vector2f& position, std::string_view icon, const uint32_t fontSize);
+  // to compute widget name and relative position to the cursor/group, names
+  // are stored until the widget is computed again in the next frame
+  const std::string& initializeActivable (const std::string& key);
   sf::Vector2f computeRelativePosition (const sf::Vector2f& displacement = {}) const;
   // to handle appearance options
-  WidgetDrawOptions drawOptions (const WidgetAspect& standard, const WidgetAspect& custom = {}, const bool horizontal = true, const float progress = 1.f) const;
+  WidgetDrawOptions drawOptions (const WidgetAspectView& standard, const WidgetAspectView& custom = {}, const bool horizontal = true, const float progress = 1.f) const;
   bool isValid (const Widget widget) const;
   bool isValid (const Slices slices) const;
   bool isValid (const ItemState state) const;
-  bool isValid (const std::string& image) const;
+  bool isValid (std::string_view image) const;
   // to draw text description of widgets
-  sf::Vector2f widgetDescription (const sf::Vector2f& position, const std::string& description);
+  sf::Vector2f widgetDescription (const sf::Vector2f& position, std::string_view description);
   // to compute widget spacing and scrolling
   void updateSpacing (const sf::Vector2f& size);
   void updateScrolling ();
@@ -512,12 +675,19 @@ private:
   // to process sfml events and store it in the internal state
   void handleMouseInputs (const sf::RenderWindow& window, const std::optional <sf::Event>& event);
   void handleKeyboardInputs (const std::optional <sf::Event>& event);
+  // apply events in order until one conflicts with this frame inputs, return
+  // the number of events applied and the last pointer position in pixels
+  size_t handleInputsQueue (std::optional <sf::Vector2i>& pointer);
+  // drop waiting events above InputState::MaxPendingEvents
+  void boundInputsQueue ();
   // to play sounds
   void playSound (const ItemState state);
 private:
   // plot parameters
   bool mPlotIsBounded = false;
   uint32_t mPlotSample = 50u;
+  ThreadPool* mPlotWorkers = nullptr;
+  uint64_t mPlotDataVersion = 0u;
   // Tooltip clock
   sf::Clock mInternalClock = {};
   float mTipAppearClock = 0.f;
@@ -532,6 +702,19 @@ private:
   Impl::Counters mCounters = {};
   Impl::GroupChecker mChecker = {};
   std::string mWidgetChain = "";
+  std::deque <std::string> mWidgetNames;
+  // memory of frames, if an arena is used
+  std::unique_ptr <FrameArena> mFrameArena;
+  // channels consumers drained at each frame
+  std::vector <ChannelSink*> mChannelSinks;
+  std::vector <sf::Vector2f> mStreamPoints;
+  // buffers of formula sampling
+  std::vector <float> mExpressionX;
+  std::vector <float> mExpressionY;
+  // buffers for text formatting
+  mutable std::pmr::string mTruncatedText;
+  std::pmr::string mLabelledNumber;
+  mutable std::pmr::vector <std::string_view> mFormattedLines;
   // alignement data
   sf::Vector2f mCursorPosition = {};
   sf::Vector2f mPadding = {6.f, 1.5f};
@@ -547,7 +730,9 @@ private:
   // render for gui, plot and primitive shape
   Style mStyle;
   sf::Font* mFont;
-  sf::Font mFontawesome;
+  // own face, on bundle bytes shared by all gui
+  std::shared_ptr<const sf::Font> mFontawesome;
+  Formula mFormula;
   Plotter mPlotter;
   GuiRender mRender;
   PrimitiveShapeRender mColorRender;
@@ -566,7 +751,7 @@ private:
   ObjectPool <uint8_t, std::string> mTextHasCursor;
   ObjectPool <float> mComboBoxClocks;
   ObjectPool <Panel, std::string> mInputTextPanels;
-  ObjectPool <std::vector <sf::Vector2f>> mPlotsData;
+  ObjectPool <Impl::PlotData> mPlotsData;
   ObjectPool <Impl::ScrollerInformation> mGroupsScrollerData;
 };
 
@@ -9,10 +9,10 @@ void Gui::slider (
   Type& value,
   const Type min,
   const Type max,
-  const WidgetOptions& options)
+  const WidgetOptionsView& options)
 {
   // initialize widget if and position
-  const auto name = initializeActivable ("Slider");
+  const auto& name = initializeActivable ("Slider");
   const auto position = computeRelativePosition (options.displacement);
 
   // get status of the widget
@@ -66,26 +66,28 @@ Type Gui::sliderValue (
 template <typename Type>
 void Gui::inputNumber (
   Type& number,
-  const WidgetOptions& options,
+  const WidgetOptionsView& options,
   const Type min,
   const Type max,
-  const std::string& label,
+  std::string_view label,
   const bool fixedWidth)
 {
   // Initialize widget name and position
   auto numStr = formatNumberToString (number);
-  const auto name = initializeActivable ("NumberInput");
+  const auto& name = initializeActivable ("NumberInput");
   const auto position = computeRelativePosition (options.displacement);
   if (!mTextCursorPositions.has (name)) {
     mTextCursorPositions.emplace (name, numStr.length ());
     mTextHasCursor.emplace (name, 1u);
   }
 
-  // compute text box dimension
-  auto width = textSize (label + "10000").x;
+  // compute text box dimension, label and number are joined in a reused buffer
+  mLabelledNumber.assign (label);
+  mLabelledNumber.append ("10000");
+  auto width = textSize (mLabelledNumber).x;
   if (!fixedWidth) {
-    const auto numStr = formatNumberToString (number);
-    width = std::max (width, textSize (label + numStr).x);
+    mLabelledNumber.replace (label.size (), std::string::npos, numStr);
+    width = std::max (width, textSize (mLabelledNumber).x);
   }
   const auto boxSize = sf::Vector2f (width + 4.f*mPadding.x, textHeight ());
 
@@ -116,10 +118,10 @@ void Gui::inputNumber (
   mRender.draw (box, drawOptions ({Widget::TextBox, Slices::Three, state}, options.aspect));
 
   // draw label and number
-  const auto inputStr = label + numStr;
+  mLabelledNumber.replace (label.size (), std::string::npos, numStr);
   const auto numWidth = textSize (numStr).x;
   const auto shiftToCenter = sf::Vector2f ((boxSize.x - numWidth) / 2.f - mPadding.x, mPadding.y);
-  handleTextDrawing (position + shiftToCenter, inputStr);
+  handleTextDrawing (position + shiftToCenter, mLabelledNumber);
   if (focused) {
     const auto labelShift = sf::Vector2f (textSize (label).x, 0.f);
     drawTextCursor (position + shiftToCenter + labelShift, name, numStr, {});
@@ -136,7 +138,7 @@ void Gui::inputNumber (
 template <typename Type>
 void Gui::inputVector2 (
   sf::Vector2<Type>& vector,
-  const WidgetOptions& options,
+  const WidgetOptionsView& options,
   const sf::Vector2<Type>& min,
   const sf::Vector2<Type>& max)
 {
@@ -157,7 +159,7 @@ void Gui::inputVector2 (
 template <typename Type>
 void Gui::inputVector3 (
   sf::Vector3<Type>& vector,
-  const WidgetOptions& options,
+  const WidgetOptionsView& options,
   const sf::Vector3<Type>& min,
   const sf::Vector3<Type>& max)
 {
@@ -248,4 +250,36 @@ std::string Gui::formatNumberToString (const Type& number) const
   return fmt::format ("{}", number);
 }
 
+
+/**
+ *  plot
+ */
+/////////////////////////////////////////////////
+template <typename Function, typename>
+void Gui::plot (
+  const Function& slope,
+  const float thickness,
+  const sf::Color& lineColor)
+{
+  // cache plot data to avoid useless computation
+  if (!mPlotsData.has (mCounters.plot)) {
+    cachePlotData (slope, mPlotter.xRange);
+  }
+  plotData (mPlotsData.get (mCounters.plot), thickness, lineColor);
+  mCounters.plot++;
+}
+
+/////////////////////////////////////////////////
+template <typename Function>
+void Gui::cachePlotData (
+  const Function& slope,
+  const PlotRange& range)
+{
+  auto data = Impl::PlotData ();
+  data.version = ++mPlotDataVersion;
+  data.points.resize (mPlotSample);
+  samplePlot (slope, range, mPlotSample, 0, data.points, mPlotWorkers);
+  mPlotsData.emplace (mCounters.plot, std::move (data));
+}
+
 } // namespace sgui
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <SFML/Graphics/Rect.hpp>
+#include <SFML/Window/Event.hpp>
 #include <SFML/Window/Keyboard.hpp>
 
 namespace sgui 
@@ -50,6 +52,10 @@ struct InputState
   bool textIsEntered = false;
   char32_t keyPressed;
   sf::Keyboard::Key code;
+  // events left for the next frames by batched update, in order, bounded so
+  // that a stalled application can't let it grow
+  static constexpr size_t MaxPendingEvents = 256u;
+  std::vector <sf::Event> pendingEvents;
 };
 
 } // namespace Impl
@@ -0,0 +1,49 @@
+#include <cstring>
+#include "sgui/Internals/PlotData.h"
+
+namespace sgui::Impl
+{
+namespace
+{
+/////////////////////////////////////////////////
+uint32_t bitsOf (const float value)
+{
+  auto bits = uint32_t (0);
+  std::memcpy (&bits, &value, sizeof (bits));
+  return bits;
+}
+} // namespace
+
+/////////////////////////////////////////////////
+uint64_t hashPoints (const std::vector<sf::Vector2f>& points)
+{
+  auto hash = uint64_t (14695981039346656037u);
+  for (const auto& point : points) {
+    hash = hashWord (bitsOf (point.x), hash);
+    hash = hashWord (bitsOf (point.y), hash);
+  }
+  return hash ^ points.size ();
+}
+
+/////////////////////////////////////////////////
+uint64_t hashValues (
+  const std::vector<float>& values,
+  const uint64_t seed)
+{
+  auto hash = seed;
+  for (const auto value : values) {
+    hash = hashWord (bitsOf (value), hash);
+  }
+  return hash ^ values.size ();
+}
+
+/////////////////////////////////////////////////
+uint64_t hashWord (
+  const uint32_t word,
+  const uint64_t seed)
+{
+  // fnv-1a on 32 bits words, far cheaper than generating the plot mesh
+  return (seed ^ word) * 1099511628211u;
+}
+
+} // namespace sgui::Impl
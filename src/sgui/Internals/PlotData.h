@@ -0,0 +1,38 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <SFML/System/Vector2.hpp>
+
+#include "sgui/Render/Plotter.h"
+
+namespace sgui::Impl
+{
+/**
+ * @brief sampled data of a plot, version change each time data are recomputed
+ */
+struct PlotData
+{
+  uint64_t version = 0u;
+  uint64_t source = 0u; ///< version of the sampled source, if it has one
+  PlotRange range = {};  ///< x range on which source was sampled
+  uint32_t sample = 0u;  ///< number of samples taken on the range
+  std::vector<sf::Vector2f> points;
+};
+
+/**
+ * @brief hash points, used as version of user data that are not cached
+ */
+uint64_t hashPoints (const std::vector<sf::Vector2f>& points);
+
+/**
+ * @brief combine values in a hash
+ */
+uint64_t hashValues (const std::vector<float>& values, const uint64_t seed);
+
+/**
+ * @brief combine a single word in a hash
+ */
+uint64_t hashWord (const uint32_t word, const uint64_t seed);
+
+} // namespace sgui::Impl
@@ -0,0 +1,645 @@
+#include "Expression.h"
+
+#include <cmath>
+#include <atomic>
+#include <cstdlib>
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace sgui
+{
+namespace Parser
+{
+namespace
+{
+// number of values evaluated at once, stack of a block fit in L1 cache
+constexpr auto BlockSize = size_t (256);
+
+// versions are unique between all expressions
+std::atomic<uint64_t> NextVersion = 1u;
+
+// half of π, used by arccot
+constexpr auto HalfPi = 1.57079632679489661923f;
+
+/////////////////////////////////////////////////
+// decode an utf-8 character of at most two bytes, as greek letters
+char32_t decodeCharacter (const std::string& text, const size_t position, size_t& length)
+{
+  const auto first = static_cast<unsigned char> (text [position]);
+  if ((first & 0xE0u) == 0xC0u && position + 1 < text.size ()) {
+    const auto second = static_cast<unsigned char> (text [position + 1]);
+    if ((second & 0xC0u) == 0x80u) {
+      length = 2;
+      return ((first & 0x1Fu) << 6) | (second & 0x3Fu);
+    }
+  }
+  length = 1;
+  return first;
+}
+
+/////////////////////////////////////////////////
+// apply function on a block, with one loop per function so it can be vectorized
+template <typename Operation>
+void transform (float* values, const size_t count, const Operation& operation)
+{
+  for (size_t i = 0; i < count; i++) {
+    values [i] = operation (values [i]);
+  }
+}
+
+/////////////////////////////////////////////////
+void applyAll (const Function function, float* values, const size_t count)
+{
+  switch (function) {
+    case Function::sqrt:   transform (values, count, [] (float v) { return std::sqrt (v); }); break;
+    case Function::ln:     transform (values, count, [] (float v) { return std::log (v); }); break;
+    case Function::log:    transform (values, count, [] (float v) { return std::log10 (v); }); break;
+    case Function::exp:    transform (values, count, [] (float v) { return std::exp (v); }); break;
+    case Function::cos:    transform (values, count, [] (float v) { return std::cos (v); }); break;
+    case Function::sin:    transform (values, count, [] (float v) { return std::sin (v); }); break;
+    case Function::tan:    transform (values, count, [] (float v) { return std::tan (v); }); break;
+    case Function::cotan:  transform (values, count, [] (float v) { return 1.f / std::tan (v); }); break;
+    case Function::arccos: transform (values, count, [] (float v) { return std::acos (v); }); break;
+    case Function::arcsin: transform (values, count, [] (float v) { return std::asin (v); }); break;
+    case Function::arctan: transform (values, count, [] (float v) { return std::atan (v); }); break;
+    case Function::arccot: transform (values, count, [] (float v) { return HalfPi - std::atan (v); }); break;
+    default: break;
+  }
+}
+
+/////////////////////////////////////////////////
+bool isGreek (const Symbol symbol)
+{
+  return symbol >= Symbol::Alpha && symbol <= Symbol::omega;
+}
+
+} // namespace
+
+
+/**
+ * Recursive descent parser of the formula, with the usual precedence:
+ *   sum     = product (('+' | '-') product)*
+ *   product = unary (('*' | '·' | '×' | '/') unary | implicit unary)*
+ *   unary   = ('-' | '+') unary | power
+ *   power   = primary ('^' unary)?
+ *   primary = number | variable | #function (sum) | (sum)
+ */
+struct Expression::Compiler
+{
+  const std::string& text;
+  const std::string& variable;
+  std::vector<Instruction>& program;
+  std::vector<std::string>& names;
+  size_t position = 0u;
+  uint32_t depth = 0u;
+  uint32_t maxDepth = 0u;
+  std::string error = {};
+
+  /////////////////////////////////////////////////
+  void skipSpace ()
+  {
+    while (position < text.size () && text [position] == ' ') {
+      position++;
+    }
+  }
+
+  /////////////////////////////////////////////////
+  bool atEnd ()
+  {
+    skipSpace ();
+    return position >= text.size () || !error.empty ();
+  }
+
+  /////////////////////////////////////////////////
+  void fail (const std::string& message)
+  {
+    if (error.empty ()) {
+      error = message;
+    }
+  }
+
+  /////////////////////////////////////////////////
+  // longest function or symbol name just after a '#', its size is 0 if none
+  size_t matchName (Function& function, Symbol& symbol) const
+  {
+    const auto match = Parser::matchName (std::string_view (text).substr (position + 1));
+    function = Function::None;
+    symbol = Symbol::None;
+    if (match.functionSize >= match.symbolSize) {
+      function = match.function;
+      return match.functionSize;
+    }
+    symbol = match.symbol;
+    return match.symbolSize;
+  }
+
+  /////////////////////////////////////////////////
+  // consume a multiplication operator, *, ·, × or #dot, #time
+  bool acceptProduct ()
+  {
+    skipSpace ();
+    if (position >= text.size ()) {
+      return false;
+    }
+    const auto c = static_cast<unsigned char> (text [position]);
+    // '·' truncated to a char by removeSpace
+    if (c == '*' || c == 0xB7u) {
+      position++;
+      return true;
+    }
+    auto length = size_t (0);
+    const auto character = decodeCharacter (text, position, length);
+    if (length == 2 && (character == dot || character == time)) {
+      position += 2;
+      return true;
+    }
+    if (c == '#') {
+      auto function = Function::None;
+      auto symbol = Symbol::None;
+      length = matchName (function, symbol);
+      if (symbol == Symbol::dot || symbol == Symbol::time) {
+        position += length + 1;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /////////////////////////////////////////////////
+  // check if a primary start here, for implicit product like 2x
+  bool startPrimary ()
+  {
+    skipSpace ();
+    if (position >= text.size ()) {
+      return false;
+    }
+    const auto c = text [position];
+    if (c == '(' || c == '#' || c == '.' || isLitteral (c) || (c >= '0' && c <= '9')) {
+      return true;
+    }
+    auto length = size_t (0);
+    const auto character = decodeCharacter (text, position, length);
+    return length == 2 && character != dot && character != time;
+  }
+
+  /////////////////////////////////////////////////
+  void push (const Instruction& instruction)
+  {
+    program.push_back (instruction);
+    program.back ().slot = depth++;
+    maxDepth = std::max (maxDepth, depth);
+  }
+
+  /////////////////////////////////////////////////
+  void pushConstant (const float value)
+  {
+    auto instruction = Instruction ();
+    instruction.code = OpCode::Constant;
+    instruction.value = value;
+    push (instruction);
+  }
+
+  /////////////////////////////////////////////////
+  void pushVariable (const std::string& name)
+  {
+    auto instruction = Instruction ();
+    if (name == variable) {
+      instruction.code = OpCode::Variable;
+    } else {
+      // parameters are shared between all their occurrences
+      const auto found = std::find (names.begin (), names.end (), name);
+      instruction.code = OpCode::Parameter;
+      instruction.index = static_cast<uint32_t> (std::distance (names.begin (), found));
+      if (found == names.end ()) {
+        names.push_back (name);
+      }
+    }
+    push (instruction);
+  }
+
+  /////////////////////////////////////////////////
+  void emitBinary (const OpCode code)
+  {
+    if (program.size () < 2) {
+      return;
+    }
+    const auto& left = program [program.size () - 2];
+    const auto& right = program.back ();
+    // fold constant operands
+    if (left.code == OpCode::Constant && right.code == OpCode::Constant) {
+      const auto value = binary (code, left.value, right.value);
+      program.resize (program.size () - 2);
+      depth -= 2;
+      pushConstant (value);
+      return;
+    }
+    // x^2 is common enough to avoid a call to pow
+    if (code == OpCode::Pow && right.code == OpCode::Constant && right.value == 2.f) {
+      program.pop_back ();
+      depth--;
+      auto instruction = Instruction ();
+      instruction.code = OpCode::Square;
+      instruction.slot = depth - 1;
+      program.push_back (instruction);
+      return;
+    }
+    depth--;
+    auto instruction = Instruction ();
+    instruction.code = code;
+    instruction.slot = depth - 1;
+    program.push_back (instruction);
+  }
+
+  /////////////////////////////////////////////////
+  void emitUnary (const OpCode code, const Function function = Function::None)
+  {
+    if (program.empty ()) {
+      return;
+    }
+    // fold constant operand
+    auto& operand = program.back ();
+    if (operand.code == OpCode::Constant) {
+      operand.value = code == OpCode::Negate ? -operand.value : apply (function, operand.value);
+      return;
+    }
+    auto instruction = Instruction ();
+    instruction.code = code;
+    instruction.function = function;
+    instruction.slot = depth - 1;
+    program.push_back (instruction);
+  }
+
+  /////////////////////////////////////////////////
+  static float binary (const OpCode code, const float a, const float b)
+  {
+    switch (code) {
+      case OpCode::Add: return a + b;
+      case OpCode::Sub: return a - b;
+      case OpCode::Mul: return a * b;
+      case OpCode::Div: return a / b;
+      case OpCode::Pow: return std::pow (a, b);
+      default: return 0.f;
+    }
+  }
+
+  /////////////////////////////////////////////////
+  void parseSum ()
+  {
+    parseProduct ();
+    while (!atEnd ()) {
+      const auto c = text [position];
+      if (c != '+' && c != '-') {
+        return;
+      }
+      position++;
+      parseProduct ();
+      emitBinary (c == '+' ? OpCode::Add : OpCode::Sub);
+    }
+  }
+
+  /////////////////////////////////////////////////
+  void parseProduct ()
+  {
+    parseUnary ();
+    while (!atEnd ()) {
+      if (acceptProduct ()) {
+        parseUnary ();
+        emitBinary (OpCode::Mul);
+      } else if (text [position] == '/') {
+        position++;
+        parseUnary ();
+        emitBinary (OpCode::Div);
+      } else if (startPrimary ()) {
+        parseUnary ();
+        emitBinary (OpCode::Mul);
+      } else {
+        return;
+      }
+    }
+  }
+
+  /////////////////////////////////////////////////
+  void parseUnary ()
+  {
+    skipSpace ();
+    if (position < text.size () && (text [position] == '-' || text [position] == '+')) {
+      const auto negate = text [position] == '-';
+      position++;
+      parseUnary ();
+      if (negate) {
+        emitUnary (OpCode::Negate);
+      }
+      return;
+    }
+    parsePower ();
+  }
+
+  /////////////////////////////////////////////////
+  void parsePower ()
+  {
+    parsePrimary ();
+    if (!atEnd () && text [position] == '^') {
+      position++;
+      // right associative, 2^3^2 = 2^9
+      parseUnary ();
+      emitBinary (OpCode::Pow);
+    }
+  }
+
+  /////////////////////////////////////////////////
+  void parseParentheses ()
+  {
+    skipSpace ();
+    if (position >= text.size () || text [position] != '(') {
+      fail ("expected '('");
+      return;
+    }
+    position++;
+    parseSum ();
+    if (atEnd () || text [position] != ')') {
+      fail ("expected ')'");
+      return;
+    }
+    position++;
+  }
+
+  /////////////////////////////////////////////////
+  // digits with an optional decimal part and exponent, like 1.5e-3
+  std::string scanNumber ()
+  {
+    const auto start = position;
+    const auto isDigit = [this] (const size_t i) {
+      return i < text.size () && text [i] >= '0' && text [i] <= '9';
+    };
+    while (isDigit (position) || (position < text.size () && text [position] == '.')) {
+      position++;
+    }
+    // exponent is only read if it's complete, otherwise e is a variable
+    if (position < text.size () && (text [position] == 'e' || text [position] == 'E')) {
+      auto next = position + 1;
+      if (next < text.size () && (text [next] == '+' || text [next] == '-')) {
+        next++;
+      }
+      if (isDigit (next)) {
+        position = next;
+        while (isDigit (position)) {
+          position++;
+        }
+      }
+    }
+    return text.substr (start, position - start);
+  }
+
+  /////////////////////////////////////////////////
+  void parsePrimary ()
+  {
+    skipSpace ();
+    if (position >= text.size ()) {
+      fail ("unexpected end of formula");
+      return;
+    }
+    const auto c = text [position];
+    // number
+    if ((c >= '0' && c <= '9') || c == '.') {
+      const auto number = scanNumber ();
+      auto* end = static_cast<char*> (nullptr);
+      const auto value = std::strtof (number.c_str (), &end);
+      if (end != number.c_str () + number.size ()) {
+        fail ("invalid number");
+        return;
+      }
+      pushConstant (value);
+      return;
+    }
+    // group
+    if (c == '(') {
+      parseParentheses ();
+      return;
+    }
+    // latin variable
+    if (isLitteral (c)) {
+      position++;
+      pushVariable (std::string (1, c));
+      return;
+    }
+    // function or greek variable
+    if (c == '#') {
+      auto function = Function::None;
+      auto symbol = Symbol::None;
+      const auto length = matchName (function, symbol);
+      if (function != Function::None) {
+        position += length + 1;
+        parseParentheses ();
+        emitUnary (OpCode::Call, function);
+        return;
+      }
+      if (isGreek (symbol)) {
+        position += length + 1;
+        pushVariable (toString (symbol));
+        return;
+      }
+      fail ("unknown function or symbol");
+      return;
+    }
+    // greek letter typed directly
+    auto length = size_t (0);
+    const auto character = decodeCharacter (text, position, length);
+    for (const auto& entry : Symbols) {
+      if (isGreek (entry.first) && entry.second.character == character) {
+        position += length;
+        pushVariable (entry.second.identifier);
+        return;
+      }
+    }
+    fail ("unexpected character");
+  }
+};
+
+
+/////////////////////////////////////////////////
+float apply (
+  const Function function,
+  const float value)
+{
+  switch (function) {
+    case Function::sqrt:   return std::sqrt (value);
+    case Function::ln:     return std::log (value);
+    case Function::log:    return std::log10 (value);
+    case Function::exp:    return std::exp (value);
+    case Function::cos:    return std::cos (value);
+    case Function::sin:    return std::sin (value);
+    case Function::tan:    return std::tan (value);
+    case Function::cotan:  return 1.f / std::tan (value);
+    case Function::arccos: return std::acos (value);
+    case Function::arcsin: return std::asin (value);
+    case Function::arctan: return std::atan (value);
+    case Function::arccot: return HalfPi - std::atan (value);
+    default: return value;
+  }
+}
+
+/////////////////////////////////////////////////
+bool Expression::compile (
+  const std::string& formula,
+  const std::string& variable)
+{
+  // variable can be given with or without its #
+  const auto name = !variable.empty () && variable.front () == '#' ? variable.substr (1) : variable;
+  auto program = std::vector<Instruction> ();
+  auto names = std::vector<std::string> ();
+  auto compiler = Compiler {formula, name, program, names};
+  compiler.parseSum ();
+  if (compiler.error.empty () && !compiler.atEnd ()) {
+    compiler.fail ("unexpected character");
+  }
+  if (compiler.error.empty () && program.empty ()) {
+    compiler.fail ("empty formula");
+  }
+  if (!compiler.error.empty ()) {
+    spdlog::error ("Expression::compile, {} at position {} of \"{}\"", compiler.error, compiler.position, formula);
+    return false;
+  }
+
+  // keep values of parameters that are still used
+  auto parameters = std::vector<float> (names.size (), 0.f);
+  for (size_t p = 0; p < names.size (); p++) {
+    const auto found = std::find (mParameterNames.begin (), mParameterNames.end (), names [p]);
+    if (found != mParameterNames.end ()) {
+      parameters [p] = mParameters [std::distance (mParameterNames.begin (), found)];
+    } else if (names [p] == "pi") {
+      parameters [p] = 2.f * HalfPi;
+    }
+  }
+  mProgram = std::move (program);
+  mParameterNames = std::move (names);
+  mParameters = std::move (parameters);
+  mDepth = compiler.maxDepth;
+  mVersion = NextVersion++;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool Expression::isValid () const
+{
+  return !mProgram.empty ();
+}
+
+/////////////////////////////////////////////////
+uint64_t Expression::version () const
+{
+  return mVersion;
+}
+
+/////////////////////////////////////////////////
+size_t Expression::size () const
+{
+  return mProgram.size ();
+}
+
+/////////////////////////////////////////////////
+bool Expression::setVariable (
+  const std::string& name,
+  const float value)
+{
+  const auto id = !name.empty () && name.front () == '#' ? name.substr (1) : name;
+  const auto found = std::find (mParameterNames.begin (), mParameterNames.end (), id);
+  if (found == mParameterNames.end ()) {
+    return false;
+  }
+  // a new value changes results, so users of the version sample it again
+  auto& parameter = mParameters [std::distance (mParameterNames.begin (), found)];
+  if (parameter != value) {
+    parameter = value;
+    mVersion = NextVersion++;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+float Expression::operator() (const float variable) const
+{
+  auto output = 0.f;
+  evaluate (&variable, &output, 1);
+  return output;
+}
+
+/////////////////////////////////////////////////
+void Expression::evaluate (
+  const std::vector<float>& variable,
+  std::vector<float>& output) const
+{
+  output.resize (variable.size ());
+  evaluate (variable.data (), output.data (), variable.size ());
+}
+
+/////////////////////////////////////////////////
+void Expression::evaluate (
+  const float* variable,
+  float* output,
+  const size_t count) const
+{
+  if (mProgram.empty ()) {
+    std::fill (output, output + count, 0.f);
+    return;
+  }
+
+  // stack is local to stay thread safe, it's reused by each block
+  auto stack = std::vector<float> (static_cast<size_t> (mDepth) * std::min (count, BlockSize));
+  for (size_t first = 0; first < count; first += BlockSize) {
+    const auto size = std::min (BlockSize, count - first);
+    run (variable + first, output + first, size, stack.data ());
+  }
+}
+
+/////////////////////////////////////////////////
+void Expression::run (
+  const float* variable,
+  float* output,
+  const size_t count,
+  float* stack) const
+{
+  // each instruction is a tight loop over the block, so it can be vectorized
+  for (const auto& instruction : mProgram) {
+    auto* a = stack + instruction.slot * count;
+    const auto* b = a + count;
+    switch (instruction.code) {
+      case OpCode::Constant:
+        std::fill (a, a + count, instruction.value);
+        break;
+      case OpCode::Variable:
+        std::copy (variable, variable + count, a);
+        break;
+      case OpCode::Parameter:
+        std::fill (a, a + count, mParameters [instruction.index]);
+        break;
+      case OpCode::Add:
+        for (size_t i = 0; i < count; i++) a [i] += b [i];
+        break;
+      case OpCode::Sub:
+        for (size_t i = 0; i < count; i++) a [i] -= b [i];
+        break;
+      case OpCode::Mul:
+        for (size_t i = 0; i < count; i++) a [i] *= b [i];
+        break;
+      case OpCode::Div:
+        for (size_t i = 0; i < count; i++) a [i] /= b [i];
+        break;
+      case OpCode::Pow:
+        for (size_t i = 0; i < count; i++) a [i] = std::pow (a [i], b [i]);
+        break;
+      case OpCode::Square:
+        for (size_t i = 0; i < count; i++) a [i] *= a [i];
+        break;
+      case OpCode::Negate:
+        for (size_t i = 0; i < count; i++) a [i] = -a [i];
+        break;
+      case OpCode::Call:
+        applyAll (instruction.function, a, count);
+        break;
+    }
+  }
+  std::copy (stack, stack + count, output);
+}
+
+} // namespace Parser
+} // namespace sgui
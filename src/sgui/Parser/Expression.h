@@ -0,0 +1,122 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "MathParser.h"
+
+namespace sgui
+{
+namespace Parser
+{
+/**
+ * @brief mathematical expression compiled into a stack bytecode, so that it
+ *   can be evaluated on whole arrays of samples. It uses the formula syntax:
+ *   +, -, *, ·, ×, /, ^, parentheses, #function (...) and implicit products
+ *   like 2x or 3#sin(x). Single letters and greek symbols (#alpha, ...) are
+ *   variables, the plotted one is set at compilation, others are parameters
+ *   that can be changed with setVariable. Constant sub-expressions are folded
+ *   at compilation.
+ */
+class Expression
+{
+public:
+  Expression () = default;
+  /**
+   * @brief compile a formula, previous program is kept if it fails
+   * @param formula is the expression to compile, e.g. "#sin(2x) + #alpha·x^2"
+   * @param variable is the name of the sampled variable, a letter or a greek
+   *   symbol identifier like "theta"
+   * @return true if the formula was compiled
+   */
+  bool compile (
+    const std::string& formula,
+    const std::string& variable = "x");
+  /**
+   * @brief check if an expression was compiled
+   */
+  bool isValid () const;
+  /**
+   * @brief version of the program, it changes on each successful compilation
+   *   and each time a parameter value changes
+   */
+  uint64_t version () const;
+  /**
+   * @brief number of instructions of the program, after constant folding
+   */
+  size_t size () const;
+  /**
+   * @brief set value of a parameter of the expression, pi default to π and
+   *   others to 0. Unknown names are ignored.
+   * @return true if the expression use this parameter
+   */
+  bool setVariable (
+    const std::string& name,
+    const float value);
+  /**
+   * @brief evaluate expression for a single value, prefer evaluate for arrays
+   */
+  float operator() (const float variable) const;
+  /**
+   * @brief evaluate expression on count values, results are written in output.
+   *   It's thread safe as long as parameters are not modified meanwhile.
+   */
+  void evaluate (
+    const float* variable,
+    float* output,
+    const size_t count) const;
+  /**
+   * @brief evaluate expression on an array of values, output is resized
+   */
+  void evaluate (
+    const std::vector<float>& variable,
+    std::vector<float>& output) const;
+private:
+  enum class OpCode : uint8_t {
+    Constant,
+    Variable,
+    Parameter,
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Pow,
+    Square,
+    Negate,
+    Call
+  };
+  // instruction writes its result in the stack slot, binary operations read
+  // slot and slot + 1
+  struct Instruction {
+    OpCode code = OpCode::Constant;
+    Function function = Function::None;
+    uint32_t slot = 0u;
+    uint32_t index = 0u;
+    float value = 0.f;
+  };
+  // recursive descent parser, it emits program in postfix order
+  struct Compiler;
+  // run program on a block of values
+  void run (
+    const float* variable,
+    float* output,
+    const size_t count,
+    float* stack) const;
+private:
+  uint64_t mVersion = 0u;
+  uint32_t mDepth = 0u;
+  std::vector<Instruction> mProgram;
+  std::vector<std::string> mParameterNames;
+  std::vector<float> mParameters;
+};
+
+/**
+ * @brief apply a parsed function on a value
+ */
+float apply (
+  const Function function,
+  const float value);
+
+} // namespace Parser
+} // namespace sgui
@@ -0,0 +1,579 @@
+#include "Formula.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace sgui
+{
+namespace
+{
+// glyph quads are enlarged to avoid cutting their anti-aliased edges
+constexpr auto GlyphPadding = 1.f;
+
+} // namespace
+
+/////////////////////////////////////////////////
+Formula::Formula (const sf::Font& font)
+  : mathFont (&font)
+{}
+
+/////////////////////////////////////////////////
+void Formula::setFont (const sf::Font& font)
+{
+  mathFont = &font;
+  layouts.clear ();
+}
+
+/////////////////////////////////////////////////
+const Formula::Geometry& Formula::geometry (const std::string& str, const Style& style)
+{
+  setStyle (style);
+  return layout (str).geometry;
+}
+
+/////////////////////////////////////////////////
+void Formula::printFormula (const std::string& str, sf::RenderWindow& screen, const Style& style)
+{
+  setStyle (style);
+  const auto& formula = layout (str);
+  if (formula.root == NoNode) {
+    return;
+  }
+
+  // formula is laid out once at origin, it's only translated to be centered
+  const auto& root = formula.nodes [formula.root];
+  const auto xOffset = (screen.getSize ().x - root.size.width) * 0.5f;
+  const auto yOffset = std::max (0.f, screen.getSize ().y * 0.1f - root.height.up);
+  auto states = sf::RenderStates ();
+  states.transform.translate ({xOffset, yOffset});
+  for (const auto& batch : formula.geometry.batches) {
+    states.texture = &mathFont->getTexture (batch.characterSize);
+    screen.draw (batch.vertices.data (), batch.vertices.size (), sf::PrimitiveType::Triangles, states);
+  }
+}
+
+/////////////////////////////////////////////////
+float Formula::getCharacterSize ()
+{
+  return characterSize;
+}
+
+/////////////////////////////////////////////////
+void Formula::clearCache ()
+{
+  layouts.clear ();
+}
+
+/////////////////////////////////////////////////
+bool Formula::LayoutKey::operator== (const LayoutKey& other) const
+{
+  return formula == other.formula
+    && characterSize == other.characterSize
+    && color == other.color;
+}
+
+/////////////////////////////////////////////////
+size_t Formula::LayoutKeyHash::operator() (const LayoutKey& key) const
+{
+  auto hash = std::hash<std::string_view> () (key.formula);
+  hash ^= std::hash<float> () (key.characterSize) + 0x9e3779b9u + (hash << 6) + (hash >> 2);
+  hash ^= std::hash<uint32_t> () (key.color) + 0x9e3779b9u + (hash << 6) + (hash >> 2);
+  return hash;
+}
+
+/////////////////////////////////////////////////
+void Formula::setStyle (const Style& style)
+{
+  characterSize = style.fontSize.normal;
+  color = style.fontColor;
+  spacing = characterSize * 0.25f;
+}
+
+/////////////////////////////////////////////////
+const Formula::FormulaLayout& Formula::layout (const std::string& str)
+{
+  // an unchanged formula is neither parsed nor laid out again
+  const auto key = LayoutKey {str, characterSize, color.toInteger ()};
+  const auto cached = layouts.find (key);
+  layoutUses++;
+  if (cached != layouts.end ()) {
+    cached->second->lastUse = layoutUses;
+    return *cached->second;
+  }
+
+  // edited formulas would fill the cache, so the least recently used is removed
+  if (layouts.size () >= LayoutsCacheSize) {
+    const auto oldest = std::min_element (layouts.begin (), layouts.end (),
+      [] (const auto& lhs, const auto& rhs) { return lhs.second->lastUse < rhs.second->lastUse; });
+    layouts.erase (oldest);
+  }
+
+  // spaces are removed once, nodes are slices of this expression
+  auto formula = std::make_unique<FormulaLayout> ();
+  formula->key = str;
+  formula->expression = Parser::removeSpace (str);
+  formula->characterSize = characterSize;
+  formula->color = color;
+  formula->lastUse = layoutUses;
+  if (mathFont && !formula->expression.empty ()) {
+    formula->root = buildTree (*formula, formula->expression);
+    auto x = 0.f;
+    buildFormulaCoordinates (*formula, formula->root, 0.f, x);
+    buildGeometry (*formula, formula->root);
+  }
+
+  // key views the string owned by the layout, so it stay valid
+  const auto storedKey = LayoutKey {formula->key, characterSize, key.color};
+  return *layouts.emplace (storedKey, std::move (formula)).first->second;
+}
+
+
+/////////////////////////////////////////////////
+bool Formula::isOnlyTerm (const FormulaTree& node) const
+{
+  return (node.leftTree == NoNode && node.rightTree == NoNode);
+}
+
+/////////////////////////////////////////////////
+sf::FloatRect Formula::measureString (const sf::String& str, const uint32_t size) const
+{
+  // same bounds as a sf::Text, computed from glyph metrics cached by the font
+  const auto baseline = static_cast<float> (size);
+  auto x = 0.f;
+  auto min = sf::Vector2f (std::numeric_limits<float>::max (), std::numeric_limits<float>::max ());
+  auto max = sf::Vector2f (std::numeric_limits<float>::lowest (), std::numeric_limits<float>::lowest ());
+  auto previous = char32_t (0);
+  for (const auto character : str) {
+    x += mathFont->getKerning (previous, character, size);
+    previous = character;
+    const auto& glyph = mathFont->getGlyph (character, size, false);
+    if (character == ' ') {
+      min.x = std::min (min.x, x);
+      max.x = std::max (max.x, x + glyph.advance);
+    } else {
+      const auto& box = glyph.bounds;
+      min.x = std::min (min.x, x + box.position.x);
+      min.y = std::min (min.y, baseline + box.position.y);
+      max.x = std::max (max.x, x + box.position.x + box.size.x);
+      max.y = std::max (max.y, baseline + box.position.y + box.size.y);
+    }
+    x += glyph.advance;
+  }
+  if (min.x > max.x || min.y > max.y) {
+    return {};
+  }
+  return sf::FloatRect (min, max - min);
+}
+
+/////////////////////////////////////////////////
+float Formula::getWidthOfString (std::string_view str, float height)
+{
+  const auto size = static_cast<uint32_t> (characterSize + height);
+  return measureString (sf::String::fromUtf8 (str.begin (), str.end ()), size).size.x;
+}
+
+/////////////////////////////////////////////////
+float Formula::getHeightOfString (std::string_view str, float height)
+{
+  const auto size = static_cast<uint32_t> (characterSize + height);
+  return measureString (sf::String::fromUtf8 (str.begin (), str.end ()), size).size.y;
+}
+
+/////////////////////////////////////////////////
+float Formula::getWidthOfChar (const char c, float height)
+{
+  return getWidthOfString (std::string_view (&c, 1), height);
+}
+
+/////////////////////////////////////////////////
+float Formula::getHeightOfChar (const char c, float height)
+{
+  return getHeightOfString (std::string_view (&c, 1), height);
+}
+
+
+/////////////////////////////////////////////////
+uint32_t Formula::buildTree (FormulaLayout& layout, std::string_view formula)
+{
+  // create new node, nodes are only accessed by index as arena can grow
+  const auto index = static_cast<uint32_t> (layout.nodes.size ());
+  layout.nodes.emplace_back (formula);
+
+  // if it has parentheses then we eliminate them and go to the next node
+  if (formula.size () > 1 && formula.front () == '(' && formula.back () == ')') {
+    if (Parser::isNextParenthesesValid (formula)) {
+      const auto left = buildTree (layout, formula.substr (1, formula.size () - 2));
+      layout.nodes [index].parentheses = true;
+      layout.nodes [index].leftTree = left;
+      return index;
+    }
+  }
+
+  // check if the input is a function
+  const auto function = Parser::parseNextFunction (formula);
+  layout.nodes [index].function = function;
+  if (function != Parser::Function::None) {
+    const auto functionSize = Parser::toString (function).size () + 1;
+    auto argument = formula.substr (functionSize);
+    if (function == Parser::Function::sqrt) {
+      argument = argument.substr (1, argument.size () - 2);
+    }
+    const auto left = buildTree (layout, argument);
+    layout.nodes [index].leftTree = left;
+    return index;
+  }
+
+  // check what is the lowest priority operation in the current string
+  int addSubIndex = -1;
+  int addSubPriority = 1e9;
+  int mulIndex = -1;
+  int mulPriority = 1e9;
+  int divIndex = -1;
+  int divPriority = 1e9;
+  int powIndex = -1;
+  int powPriority = 1e9;
+  int currentPriority = 0;
+
+  int position = 0;
+  int continuation = 0;
+  for (const auto character : formula) {
+    // skip continuation bytes of utf-8 characters, they are not operators
+    const auto byte = static_cast<unsigned char> (character);
+    if (continuation > 0) {
+      continuation--;
+      position++;
+      continue;
+    }
+    continuation = byte >= 0xF0u ? 3 : byte >= 0xE0u ? 2 : byte >= 0xC0u ? 1 : 0;
+    // group
+    if (character == '(') currentPriority++;
+    if (character == ')') currentPriority--;
+    // addition
+    if ((character == '+' || character == '-') && currentPriority < addSubPriority) {
+      addSubPriority = currentPriority;
+      addSubIndex = position;
+    }
+    // multiplication, removeSpace store '*' and '·' in a single char
+    if ((character == '*' || byte == Parser::dot) && currentPriority < mulPriority) {
+      mulPriority = currentPriority;
+      mulIndex = position;
+    }
+    // division
+    if ((character == '/') && currentPriority < divPriority) {
+      divPriority = currentPriority;
+      divIndex = position;
+    }
+    // power
+    if ((character == '^') && currentPriority < powPriority) {
+      powPriority = currentPriority;
+      powIndex = position;
+    }
+    position++;
+  }
+
+  // check if there is at least an operator
+  if (addSubIndex == -1 && mulIndex == -1 && powIndex == -1 && divIndex == -1) {
+    return index;
+  }
+
+  // find which operator has the lowest priority and its location
+  const auto minimumPriority = std::min (std::min (addSubPriority, mulPriority), std::min (powPriority, divPriority));
+  auto operatorIndex = powIndex;
+  if (minimumPriority == addSubPriority) {
+    operatorIndex = addSubIndex;
+  } else if (minimumPriority == mulPriority) {
+    operatorIndex = mulIndex;
+  } else if (minimumPriority == divPriority) {
+    operatorIndex = divIndex;
+  }
+
+  // break the current formula in the left and right part of the operation
+  layout.nodes [index].operation = formula [operatorIndex];
+  const auto left = buildTree (layout, formula.substr (0, operatorIndex));
+  const auto right = buildTree (layout, formula.substr (operatorIndex + 1));
+  layout.nodes [index].leftTree = left;
+  layout.nodes [index].rightTree = right;
+  return index;
+}
+
+
+/////////////////////////////////////////////////
+void Formula::buildFormulaCoordinates (FormulaLayout& layout, uint32_t index, float heightPos, float& widthPos)
+{
+  // quit if there is no formula
+  if (index == NoNode) return;
+
+  // tree is complete, so references to nodes stay valid
+  auto& node = layout.nodes [index];
+  auto* leftTree = node.leftTree != NoNode ? &layout.nodes [node.leftTree] : nullptr;
+  auto* rightTree = node.rightTree != NoNode ? &layout.nodes [node.rightTree] : nullptr;
+
+  // check if node is a leaf and mark the coordinates
+  if (isOnlyTerm (node)) {
+    const auto width = getWidthOfString (node.formula);
+    node.position.xFormula = widthPos;
+    node.position.yFormula = heightPos;
+    node.height.up = heightPos;
+    node.height.down = heightPos;
+    node.size.width = width;
+    node.size.height = 0;
+    widthPos += width;
+    return;
+  }
+
+  if (node.operation == '/') {
+    // get height and width coordinates
+    const float savedWidthPos = widthPos;
+    buildFormulaCoordinates (layout, node.leftTree, heightPos - 0.7f * characterSize, widthPos);
+    widthPos = savedWidthPos;
+    buildFormulaCoordinates (layout, node.rightTree, heightPos + 0.7f * characterSize, widthPos);
+    widthPos = savedWidthPos;
+
+    // rebuild the position with correct settings
+    auto maxWidth = std::max (leftTree->size.width, rightTree->size.width);
+    widthPos += (maxWidth - leftTree->size.width) * 0.5f;
+    buildFormulaCoordinates (layout, node.leftTree, (heightPos - 0.7f * characterSize) * 2 - leftTree->height.down, widthPos);
+
+    maxWidth = std::max (leftTree->size.width, rightTree->size.width);
+    widthPos = savedWidthPos + (maxWidth - rightTree->size.width) * 0.5f;
+    buildFormulaCoordinates (layout, node.rightTree, (heightPos + 0.7f * characterSize) * 2 - rightTree->height.up + characterSize * 0.28f, widthPos);
+
+    node.height.up = leftTree->height.up;
+    node.height.down = rightTree->height.down;
+    node.size.width = maxWidth;
+    node.size.height = std::abs (node.height.down - node.height.up);
+
+    node.position.xOperator = savedWidthPos;
+    node.position.yOperator = heightPos + 0.7f * characterSize;
+
+    // reset position after fraction
+    widthPos = savedWidthPos + std::max (leftTree->size.width, rightTree->size.width);
+    return;
+  }
+  else if (node.operation == '^') {
+    // get base coordinates
+    buildFormulaCoordinates (layout, node.leftTree, heightPos, widthPos);
+    const float savedWidthPos = widthPos;
+
+    // calculate the proportion of the exponent
+    buildFormulaCoordinates (layout, node.rightTree, heightPos - characterSize * 0.7f, widthPos);
+    widthPos = savedWidthPos;
+
+    // recalculate the position depending on the size of the exponent
+    buildFormulaCoordinates (layout, node.rightTree, (heightPos - characterSize * 0.7f) * 2 - rightTree->height.down - leftTree->size.height, widthPos);
+
+    // save the information of the current formula
+    node.height.up = rightTree->height.up;
+    node.height.down = leftTree->height.down;
+    node.size.width = leftTree->size.width + rightTree->size.width;
+    node.size.height = std::max (0.f, node.height.down - node.height.up);
+    return;
+  }
+  else if (node.parentheses) {
+    node.position.xOperator = widthPos;
+    // calculate the proportion of the formula within the parentheses
+    buildFormulaCoordinates (layout, node.leftTree, heightPos, widthPos);
+
+    widthPos = node.position.xOperator + getWidthOfChar ('(', leftTree->size.height)
+      + getHeightOfChar ('(', leftTree->size.height) * 0.15f;
+
+    // recalculate the positions
+    buildFormulaCoordinates (layout, node.leftTree, heightPos, widthPos);
+
+    // adjust height of parentheses depending on the proportions of the formula
+    node.position.yOperator = (leftTree->height.down + leftTree->height.up
+      - std::abs (leftTree->height.down - leftTree->height.up)) * 0.5f
+      - (leftTree->size.height > 0 ? (getHeightOfChar ('(', leftTree->size.height) * 0.25f) : 0)
+      + (leftTree->operation == '^' ? characterSize * 0.7f : 0);
+    widthPos = widthPos + getHeightOfChar (')', leftTree->size.height) * 0.15f + getWidthOfChar (')', leftTree->size.height);
+
+    // save the information of the current formula
+    node.size.width = widthPos - node.position.xOperator;
+    node.height.up = leftTree->height.up;
+    node.height.down = leftTree->height.down;
+    node.size.height = std::abs (node.height.up - node.height.down);
+    return;
+  }
+  else if (node.function != Parser::Function::None) {
+    node.position.xOperator = widthPos;
+    node.position.yOperator = heightPos;
+    widthPos += getWidthOfString (Parser::toString (node.function));
+
+    if (node.function == Parser::Function::sqrt) {
+      buildFormulaCoordinates (layout, node.leftTree, heightPos + characterSize * 0.2f, widthPos);
+    }
+    else {
+      buildFormulaCoordinates (layout, node.leftTree, heightPos, widthPos);
+    }
+
+    node.size.width = widthPos - node.position.xOperator;
+    node.size.height = leftTree->size.height;
+    node.height.up = leftTree->height.up - characterSize * 0.20f;
+    node.height.down = leftTree->height.down;
+    return;
+  }
+  else {
+    // build the first term
+    buildFormulaCoordinates (layout, node.leftTree, heightPos, widthPos);
+
+    // build the operator
+    widthPos += spacing;
+    node.position.xOperator = widthPos;
+    node.position.yOperator = heightPos;
+    widthPos += (spacing + getWidthOfChar (node.operation));
+
+    // build the second term
+    buildFormulaCoordinates (layout, node.rightTree, heightPos, widthPos);
+
+    // save the information of the current formula
+    node.height.down = std::max (leftTree->height.down, rightTree->height.down);
+    node.height.up = std::min (leftTree->height.up, rightTree->height.up);
+    node.size.width =
+      leftTree->size.width + rightTree->size.width + 2 * spacing + getWidthOfChar (node.operation);
+    node.size.height = std::abs (node.height.down - node.height.up);
+    return;
+  }
+}
+
+
+/////////////////////////////////////////////////
+Formula::GlyphBatch& Formula::batch (FormulaLayout& layout, const uint32_t size)
+{
+  // a formula only use a few character sizes
+  auto& batches = layout.geometry.batches;
+  for (auto& glyphs : batches) {
+    if (glyphs.characterSize == size) {
+      return glyphs;
+    }
+  }
+  auto& glyphs = batches.emplace_back ();
+  glyphs.characterSize = size;
+  return glyphs;
+}
+
+/////////////////////////////////////////////////
+void Formula::appendQuad (FormulaLayout& layout, const uint32_t size, const sf::FloatRect& box, const sf::FloatRect& texture)
+{
+  // grow formula bounds
+  auto& geometry = layout.geometry;
+  const auto isEmpty = std::all_of (geometry.batches.begin (), geometry.batches.end (),
+    [] (const GlyphBatch& glyphs) { return glyphs.vertices.empty (); });
+  if (isEmpty) {
+    geometry.bounds = box;
+  } else {
+    const auto& bounds = geometry.bounds;
+    const auto min = sf::Vector2f (
+      std::min (bounds.position.x, box.position.x),
+      std::min (bounds.position.y, box.position.y));
+    const auto max = sf::Vector2f (
+      std::max (bounds.position.x + bounds.size.x, box.position.x + box.size.x),
+      std::max (bounds.position.y + bounds.size.y, box.position.y + box.size.y));
+    geometry.bounds = sf::FloatRect (min, max - min);
+  }
+
+  // append two triangles
+  auto& glyphs = batch (layout, size);
+  const auto left = box.position.x;
+  const auto top = box.position.y;
+  const auto right = left + box.size.x;
+  const auto bottom = top + box.size.y;
+  const auto u1 = texture.position.x;
+  const auto v1 = texture.position.y;
+  const auto u2 = u1 + texture.size.x;
+  const auto v2 = v1 + texture.size.y;
+  glyphs.vertices.push_back ({{left, top}, color, {u1, v1}});
+  glyphs.vertices.push_back ({{right, top}, color, {u2, v1}});
+  glyphs.vertices.push_back ({{left, bottom}, color, {u1, v2}});
+  glyphs.vertices.push_back ({{left, bottom}, color, {u1, v2}});
+  glyphs.vertices.push_back ({{right, top}, color, {u2, v1}});
+  glyphs.vertices.push_back ({{right, bottom}, color, {u2, v2}});
+}
+
+/////////////////////////////////////////////////
+void Formula::appendString (FormulaLayout& layout, const sf::String& str, const sf::Vector2f& position, const float size)
+{
+  // glyphs are placed like in a sf::Text, with its baseline at size
+  const auto characterSize = static_cast<uint32_t> (size);
+  auto x = position.x;
+  const auto y = position.y + static_cast<float> (characterSize);
+  auto previous = char32_t (0);
+  for (const auto character : str) {
+    x += mathFont->getKerning (previous, character, characterSize);
+    previous = character;
+    const auto& glyph = mathFont->getGlyph (character, characterSize, false);
+    if (character != ' ') {
+      const auto padding = sf::Vector2f (GlyphPadding, GlyphPadding);
+      const auto box = sf::FloatRect (
+        sf::Vector2f (x, y) + glyph.bounds.position - padding,
+        glyph.bounds.size + 2.f * padding);
+      const auto texture = sf::FloatRect (
+        sf::Vector2f (glyph.textureRect.position) - padding,
+        sf::Vector2f (glyph.textureRect.size) + 2.f * padding);
+      appendQuad (layout, characterSize, box, texture);
+    }
+    x += glyph.advance;
+  }
+}
+
+/////////////////////////////////////////////////
+void Formula::buildGeometry (FormulaLayout& layout, uint32_t index)
+{
+  // quit if node is empty
+  if (index == NoNode) return;
+  const auto& node = layout.nodes [index];
+
+  // base node
+  if (isOnlyTerm (node)) {
+    const auto& term = node.formula;
+    appendString (layout, sf::String::fromUtf8 (term.begin (), term.end ()), {node.position.xFormula, node.position.yFormula}, characterSize);
+    return;
+  }
+  // parentheses
+  else if (node.parentheses) {
+    const auto& leftTree = layout.nodes [node.leftTree];
+    const auto size = characterSize + leftTree.size.height * 1.2f;
+    appendString (layout, "(", {node.position.xOperator, node.position.yOperator}, size);
+    buildGeometry (layout, node.leftTree);
+    const auto x = node.position.xOperator
+      + leftTree.size.width
+      + 0.15f  * getHeightOfChar (')', leftTree.size.height)
+      + 0.609f * getWidthOfChar (')', leftTree.size.height)
+      + int (characterSize * 3 / getWidthOfChar (')', leftTree.size.height));
+    appendString (layout, ")", {x, node.position.yOperator}, size);
+    return;
+  }
+  // functions
+  else if (node.function != Parser::Function::None) {
+    const auto position = sf::Vector2f (node.position.xOperator, node.position.yOperator);
+    if (node.function == Parser::Function::sqrt) {
+      const auto& leftTree = layout.nodes [node.leftTree];
+      appendString (layout, sf::String (Parser::sqrt), position, characterSize + leftTree.size.height * 1.2f);
+    }
+    else {
+      appendString (layout, Parser::toString (node.function), position, characterSize);
+    }
+    buildGeometry (layout, node.leftTree);
+    return;
+  }
+  // operations
+  else if (node.operation == '^') {
+    buildGeometry (layout, node.leftTree);
+    buildGeometry (layout, node.rightTree);
+  }
+  else if (node.operation == '/') {
+    buildGeometry (layout, node.leftTree);
+    // fraction bar, textured with the white square of the font texture
+    const auto bar = sf::FloatRect ({node.position.xOperator, node.position.yOperator}, {node.size.width, characterSize * 0.1f});
+    appendQuad (layout, static_cast<uint32_t> (characterSize), bar, sf::FloatRect ({1.f, 1.f}, {0.f, 0.f}));
+    buildGeometry (layout, node.rightTree);
+  }
+  else {
+    buildGeometry (layout, node.leftTree);
+    const auto operation = static_cast<char32_t> (static_cast<unsigned char> (node.operation));
+    appendString (layout, sf::String (operation), {node.position.xOperator, node.position.yOperator}, characterSize);
+    buildGeometry (layout, node.rightTree);
+  }
+}
+
+} // namespace sgui
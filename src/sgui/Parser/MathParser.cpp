@@ -3,42 +3,128 @@
 #include <stack>
 #include <cstdint>
 #include <iostream>
+#include <vector>
+#include <algorithm>
+#include <spdlog/spdlog.h>
 
 namespace sgui
 {
 namespace Parser
 {
+namespace
+{
 ////////////////////////////////////////////////////////////
-std::string removeSpace (const std::string& expression)
+/**
+ * Name of a function or a symbol
+ */
+struct NameEntry
 {
-  auto formula = std::string ();
-  for (const auto& character : expression) {
-    if (character != ' ') {
-      if (character == '*') {
-        formula.push_back (dot);
+  std::string_view name;
+  Function function;
+  Symbol symbol;
+};
+
+////////////////////////////////////////////////////////////
+/**
+ * All functions and symbols names, built once from Functions and Symbols and
+ * sorted so that names sharing a prefix are contiguous and can be matched
+ * like in a trie
+ */
+std::vector <NameEntry> buildNames ()
+{
+  auto names = std::vector <NameEntry> ();
+  names.reserve (Functions.size () + Symbols.size ());
+  for (const auto& [function, name] : Functions) {
+    names.push_back (NameEntry { name, function, Symbol::None });
+  }
+  for (const auto& [symbol, data] : Symbols) {
+    names.push_back (NameEntry { data.identifier, Function::None, symbol });
+  }
+  std::sort (std::begin (names), std::end (names), [] (const NameEntry& lhs, const NameEntry& rhs) {
+    return lhs.name < rhs.name;
+  });
+  const auto duplicate = std::adjacent_find (std::begin (names), std::end (names),
+    [] (const NameEntry& lhs, const NameEntry& rhs) { return lhs.name == rhs.name; });
+  if (duplicate != std::end (names)) {
+    spdlog::error ("Parser: {} names both a function and a symbol", duplicate->name);
+  }
+  return names;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////
+NameMatch matchName (std::string_view text)
+{
+  // walk names like a trie, at each depth the range of names that share
+  // the prefix read is narrowed with the next character
+  static const auto names = buildNames ();
+  auto match = NameMatch ();
+  auto first = names.begin ();
+  auto last = names.end ();
+  for (size_t depth = 0; first != last; depth++) {
+    // shortest name of the range come first and is complete
+    if (first->name.size () == depth) {
+      if (first->function != Function::None) {
+        match.function = first->function;
+        match.functionSize = depth;
       } else {
-        formula.push_back (character);
+        match.symbol = first->symbol;
+        match.symbolSize = depth;
       }
+      first++;
+    }
+    if (depth >= text.size ()) {
+      break;
+    }
+    const auto c = text [depth];
+    first = std::lower_bound (first, last, c, [depth] (const NameEntry& entry, const char character) {
+      return entry.name [depth] < character;
+    });
+    last = std::upper_bound (first, last, c, [depth] (const char character, const NameEntry& entry) {
+      return character < entry.name [depth];
+    });
+  }
+  return match;
+}
+
+////////////////////////////////////////////////////////////
+std::string removeSpace (std::string_view expression)
+{
+  auto formula = std::string ();
+  formula.reserve (expression.size ());
+  for (size_t index = 0; index < expression.size (); index++) {
+    const auto character = expression [index];
+    if (character == ' ') {
+      continue;
+    }
+    // '*' and utf-8 '·' (C2 B7) are stored as a single char, so that the
+    // product operator is always one char long
+    const auto isUtf8Dot = static_cast<unsigned char> (character) == 0xC2u
+      && index + 1 < expression.size ()
+      && static_cast<unsigned char> (expression [index + 1]) == 0xB7u;
+    if (character == '*' || isUtf8Dot) {
+      formula.push_back (dot);
+      index += isUtf8Dot ? 1 : 0;
+    } else {
+      formula.push_back (character);
     }
   }
   return formula;
 }
 
 ////////////////////////////////////////////////////////////
-Function parseNextFunction (const std::string& expression)
+Function parseNextFunction (std::string_view expression)
 {
   // quit if first symbol is not a hashtag #
-  if (expression.front () != '#') {
+  if (expression.empty () || expression.front () != '#') {
     return Function::None;
   }
 
-  // search each function in the expression
-  for (const auto& function : Functions) {
-    // test if found function has the correct parentheses
-    const auto found = expression.find (function.second);
-    if (found == 1 && isNextParenthesesValid (expression, function.second.size () + 1)) {
-      return function.first;
-    }
+  // test if found function has the correct parentheses
+  const auto match = matchName (expression.substr (1));
+  if (match.function != Function::None && isNextParenthesesValid (expression, match.functionSize + 1)) {
+    return match.function;
   }
 
   // return no function
@@ -46,21 +132,17 @@ Function parseNextFunction (const std::string& expression)
 }
 
 ////////////////////////////////////////////////////////////
-Symbol parseNextSymbol (const std::string& expression) 
+Symbol parseNextSymbol (std::string_view expression) 
 {
   // quit if first symbol is not a hashtag #
-  if (expression.front () != '#') {
+  if (expression.empty () || expression.front () != '#') {
     return Symbol::None;
   }
 
-  // search each symbol in the expression
-  for (const auto& symbol : Symbols) {
-    // test if found symbol has the correct parentheses
-    const auto& symbolStr = symbol.second.identifier;
-    const auto found = expression.find (symbolStr);
-    if (found == 1 && isNextParenthesesValid (expression, symbolStr.size () + 1)) {
-      return symbol.first;
-    }
+  // test if found symbol has the correct parentheses
+  const auto match = matchName (expression.substr (1));
+  if (match.symbol != Symbol::None && isNextParenthesesValid (expression, match.symbolSize + 1)) {
+    return match.symbol;
   }
 
   // return no symbol
@@ -68,10 +150,13 @@ Symbol parseNextSymbol (const std::string& expression)
 }
 
 ////////////////////////////////////////////////////////////
-bool isNextParenthesesValid (const std::string& expression, int start) 
+bool isNextParenthesesValid (std::string_view expression, int start) 
 {
   // Check all pairs of parentheses
   std::stack<int> parentheses;
+  if (expression.empty ()) {
+    return false;
+  }
   for (uint32_t i = start; i < expression.size () - 1; i++) {
     if (expression[i] == '(') {
       parentheses.push (i);
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 namespace sgui 
@@ -184,22 +185,38 @@ struct SymbolData
 /**
  * Remove useless space in a mathematical expression
  */
-std::string removeSpace (const std::string& expression);
+std::string removeSpace (std::string_view expression);
+
+/**
+ * Longest function and symbol names found at the start of an expression
+ */
+struct NameMatch
+{
+  Function function = Function::None;
+  size_t functionSize = 0;
+  Symbol symbol = Symbol::None;
+  size_t symbolSize = 0;
+};
+
+/**
+ * Match function and symbol names at the start of text, in one pass
+ */
+NameMatch matchName (std::string_view text);
 
 /**
  * Check for next function in mathematical formula
  */
-Function parseNextFunction (const std::string& expression);
+Function parseNextFunction (std::string_view expression);
 
 /**
  * Check for next symbol in mathematical formula
  */
-Symbol parseNextSymbol (const std::string& expression);
+Symbol parseNextSymbol (std::string_view expression);
 
 /**
  * Check if next parentheses are in pair
  */
-bool isNextParenthesesValid (const std::string& expression, int start = 0);
+bool isNextParenthesesValid (std::string_view expression, int start = 0);
 
 /**
  * Check if character is an arithmetic operator +, -, /, *
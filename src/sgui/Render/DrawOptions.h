@@ -10,9 +10,9 @@ namespace sgui
  * @brief Store options for drawing widgets
  */
 struct WidgetDrawOptions {
-  bool horizontal = true;   ///< Specify if a widget is horizontal or vertical
-  float progress = 1.f;     ///< Percent to draw for a widget
-  WidgetAspect aspect = {}; ///< To control widget aspect
+  bool horizontal = true;       ///< Specify if a widget is horizontal or vertical
+  float progress = 1.f;         ///< Percent to draw for a widget
+  WidgetAspectView aspect = {}; ///< To control widget aspect, its image must live until drawn
 };
 
 /**
@@ -1,3 +1,4 @@
+#include <functional>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include "sgui/Render/GuiRender.h"
 #include "sgui/Core/Interpolation.h"
@@ -22,12 +23,9 @@ void GuiRender::updateView (const sf::View& newView)
 /////////////////////////////////////////////////
 uint32_t GuiRender::setCurrentClippingLayer (const sf::FloatRect& mask)
 {
-  // reserve memory for meshes and layer
-  mWidgets.emplace_back (sf::VertexArray ());
-  mWidgets.back ().setPrimitiveType (sf::PrimitiveType::Triangles);
-  mTexts.emplace_back (std::vector <sf::Text> ());
-  // store active layer id for tooltip/widgets
+  // store active layer id for tooltip/widgets, and reserve its meshes
   const auto activeLayer = clipping.setCurrentLayer (mask);
+  layer (activeLayer);
   if (mTooltipMode) {
     mTooltipLayers.emplace_back (activeLayer);
   } else {
@@ -44,37 +42,103 @@ void GuiRender::setTextureAtlas (const TextureAtlas& atlas)
   mTexturesUV.computeTextureMapping (atlas);
 }
 
+/////////////////////////////////////////////////
+void GuiRender::setTextureAtlas (const MappedTextureAtlas& atlas)
+{
+  // pre-compute texture quad
+  mTexturesUV.computeTextureMapping (atlas);
+}
+
 /////////////////////////////////////////////////
 void GuiRender::clear ()
 {
-  // clear widgets, text and layers and initialize them
-  mTexts.clear ();
-  mWidgets.clear ();
+  // clear widgets, text and layers but keep their memory
+  for (uint32_t index = 0; index < mLayersCount; index++) {
+    auto& cleared = mLayers [index];
+    cleared.widgets.clear ();
+    cleared.images.clear ();
+    cleared.glyphsCount = 0u;
+    cleared.textsCount = 0u;
+  }
+  mLayersCount = 0u;
   mWidgetLayers.clear ();
   mTooltipLayers.clear ();
   initializeClippingLayers ();
 }
 
+/////////////////////////////////////////////////
+void GuiRender::setMemoryResource (std::pmr::memory_resource* resource)
+{
+  // layers are kept, only their frame containers are rebuilt
+  mResource = resource;
+  for (auto& rebound : mLayers) {
+    rebindResource (rebound.widgets, resource);
+    rebindResource (rebound.images, resource);
+    rebindResource (rebound.glyphs, resource);
+    rebound.glyphsCount = 0u;
+    rebound.textsCount = 0u;
+  }
+  mLayersCount = 0u;
+  rebindResource (mWidgetLayers, resource);
+  rebindResource (mTooltipLayers, resource);
+  rebindResource (mWidgetState, resource);
+  rebindResource (mTextureName, resource);
+}
+
 /////////////////////////////////////////////////
 void GuiRender::initializeClippingLayers ()
 {
-  const auto layer = clipping.initialize ();
-  mWidgetLayers.emplace_back (layer);
-  mWidgets.emplace_back (sf::VertexArray ());
-  mWidgets.back ().setPrimitiveType (sf::PrimitiveType::Triangles);
-  mTexts.emplace_back (std::vector <sf::Text> ());
+  const auto baseLayer = clipping.initialize ();
+  mWidgetLayers.emplace_back (baseLayer);
+  layer (baseLayer);
+}
+
+/////////////////////////////////////////////////
+GuiRender::Layer& GuiRender::layer (const uint32_t index)
+{
+  // layers are only allocated the first time they are used
+  while (index >= mLayers.size ()) {
+    mLayers.emplace_back (mResource);
+  }
+  mLayersCount = std::max (mLayersCount, index + 1);
+  return mLayers [index];
 }
 
 /////////////////////////////////////////////////
 sf::Vector2f GuiRender::textSize (
-  const std::string& text,
+  std::string_view text,
   const sf::Font& font,
   const uint32_t fontSize) const
 {
+  // combine hash of text, font and size
+  auto key = std::hash <std::string_view> {} (text);
+  key ^= std::hash <const sf::Font*> {} (&font) + 0x9e3779b9 + (key << 6) + (key >> 2);
+  key ^= std::hash <uint32_t> {} (fontSize) + 0x9e3779b9 + (key << 6) + (key >> 2);
+  // hash may collide, so the key is checked on a hit
+  auto cached = mTextSizes.find (key);
+  if (cached != std::end (mTextSizes)
+  && cached->second.text == text
+  && cached->second.font == &font
+  && cached->second.fontSize == fontSize) {
+    return cached->second.size;
+  }
+  // compute size, cache is flushed if too many texts were measured
   auto content = sf::Text (font);
   content.setCharacterSize (fontSize);
   content.setString (sf::String::fromUtf8 (text.begin (), text.end ()));
-  return content.getLocalBounds ().size;
+  const auto size = content.getLocalBounds ().size;
+  if (cached == std::end (mTextSizes)) {
+    if (mTextSizes.size () >= TextSizesCacheSize) {
+      mTextSizes.clear ();
+    }
+    cached = mTextSizes.emplace (key, TextSize ()).first;
+  }
+  // a colliding entry is replaced by the last measured text
+  cached->second.text = text;
+  cached->second.font = &font;
+  cached->second.fontSize = fontSize;
+  cached->second.size = size;
+  return size;
 }
 
 /////////////////////////////////////////////////
@@ -103,41 +167,94 @@ void GuiRender::draw (
   const sf::FloatRect& box,
   const WidgetDrawOptions& options)
 {
+  // texture names are built in reused buffers to avoid allocations
   const auto widgetCode = toString (options.aspect.widget);
   const auto stateCode = toString (options.aspect.state);
+  mWidgetState.assign (widgetCode);
   if (options.aspect.slices == Slices::One) {
-    auto newWidget = mTexturesUV.texture (widgetCode + options.aspect.image + stateCode);
-    appendMesh (std::move (newWidget), box);
+    mWidgetState.append (options.aspect.image);
+    mWidgetState.append (stateCode);
+    appendMesh (mTexturesUV.texture (mWidgetState), box);
+    return;
   }
+  mWidgetState.append (stateCode);
   if (options.aspect.slices == Slices::Three) {
-    addThreeSlices (box, widgetCode + stateCode, options.horizontal, options.progress);
+    addThreeSlices (box, mWidgetState, options.horizontal, options.progress);
   }
   if (options.aspect.slices == Slices::Nine) {
-    addNineSlices (box, widgetCode + stateCode);
+    addNineSlices (box, mWidgetState);
   }
 }
 
 /////////////////////////////////////////////////
 void GuiRender::draw (
-  const std::string& text,
+  std::string_view text,
   const sf::Font& font,
   const TextDrawOptions& options)
 {
+  // reuse text drawn at the same place in the previous frame
+  auto& active = layer (clipping.activeLayer ());
+  if (active.textsCount == active.texts.size ()) {
+    active.texts.emplace_back (font);
+  }
+  auto& cached = active.texts [active.textsCount++];
+  auto& content = cached.text;
+  if (cached.font != &font) {
+    cached.font = &font;
+    content.setFont (font);
+  }
   // set text properties
-  auto content = sf::Text (font);
   content.setCharacterSize (options.size);
   content.setPosition (options.position);
   content.setFillColor (options.color);
-  // we use explicit utf8 encoding to handle special character like 'é'
-  content.setString (sf::String::fromUtf8 (text.begin (), text.end ()));
-  // draw text
-  mTexts.at (clipping.activeLayer ()).emplace_back (std::move (content));
+  // we use explicit utf8 encoding to handle special character like 'é',
+  // string is only converted if the text changed
+  if (cached.utf8 != text) {
+    cached.utf8.assign (text);
+    content.setString (sf::String::fromUtf8 (text.begin (), text.end ()));
+  }
+}
+
+/////////////////////////////////////////////////
+void GuiRender::draw (
+  const sf::FloatRect& box,
+  const sf::Texture& texture)
+{
+  // texture coordinates are in pixels and span the whole texture
+  auto mesh = Mesh ();
+  computeMesh (mesh, box);
+  computeMeshTexture (mesh, sf::IntRect ({0, 0}, sf::Vector2i (texture.getSize ())));
+  layer (clipping.activeLayer ()).images.emplace_back (&texture, mesh);
+}
+
+/////////////////////////////////////////////////
+void GuiRender::draw (
+  const std::vector<sf::Vertex>& vertices,
+  const sf::Texture& texture,
+  const sf::Vector2f& offset)
+{
+  // start a new batch only if texture change, batches of previous frames are reused
+  auto& active = layer (clipping.activeLayer ());
+  if (active.glyphsCount == 0u || active.glyphs [active.glyphsCount - 1].first != &texture) {
+    if (active.glyphsCount == active.glyphs.size ()) {
+      active.glyphs.emplace_back ();
+    }
+    active.glyphs [active.glyphsCount].first = &texture;
+    active.glyphs [active.glyphsCount].second.clear ();
+    active.glyphsCount++;
+  }
+  auto& batch = active.glyphs [active.glyphsCount - 1].second;
+  batch.reserve (batch.size () + vertices.size ());
+  for (auto vertex : vertices) {
+    vertex.position += offset;
+    batch.push_back (vertex);
+  }
 }
 
 /////////////////////////////////////////////////
 // To string
 /////////////////////////////////////////////////
-std::string GuiRender::toString (const Widget widget) const
+std::string_view GuiRender::toString (const Widget widget) const
 {
   if      (widget == Widget::Panel)        { return "panel"; }
   else if (widget == Widget::Window)       { return "window"; }
@@ -162,7 +279,7 @@ std::string GuiRender::toString (const Widget widget) const
 }
 
 /////////////////////////////////////////////////
-std::string GuiRender::toString (const ItemState state) const
+std::string_view GuiRender::toString (const ItemState state) const
 {
   if      (state == ItemState::Active)  { return "_a"; }
   else if (state == ItemState::Hovered) { return "_h"; }
@@ -172,15 +289,25 @@ std::string GuiRender::toString (const ItemState state) const
 
 /////////////////////////////////////////////////
 // Implementation of draw interfaces
+/////////////////////////////////////////////////
+Mesh GuiRender::sliceTexture (
+  std::string_view widgetTypeState,
+  std::string_view slice) const
+{
+  mTextureName.assign (widgetTypeState);
+  mTextureName.append (slice);
+  return mTexturesUV.texture (mTextureName);
+}
+
 /////////////////////////////////////////////////
 void GuiRender::addThreeSlices (
   const sf::FloatRect& box,
-  const std::string& widgetTypeState,
+  std::string_view widgetTypeState,
   const bool horizontal,
   const float percentToDraw)
 {
   // get texture x/y ratio
-  auto leftTexture = mTexturesUV.texture (widgetTypeState + "l");
+  auto leftTexture = sliceTexture (widgetTypeState, "l");
   const auto textureSize = leftTexture[4].texCoords - leftTexture[0].texCoords;
 
   // compute end part size
@@ -219,21 +346,21 @@ void GuiRender::addThreeSlices (
   // the filling percent is simply the total percent divided by the fraction taken by the slice
   const auto pLeft = sgui::clamp (0.f, 1.f, percentToDraw / percentEnd);
   if (percentToDraw > 0.01f && pLeft > 0.01f) {
-    auto leftBox = mTexturesUV.texture (widgetTypeState + "l");
+    auto leftBox = sliceTexture (widgetTypeState, "l");
     appendMesh (std::move (leftBox), sf::FloatRect (leftPos, endSize), horizontal, pLeft);
   }
 
   // draw middle if box is large enough
   const auto pMiddle  = sgui::clamp (0.f, 1.f, (percentToDraw - percentEnd) / percentMiddle);
   if (centerSize.length () > 0.01f && pMiddle > 0.01f) {
-    auto centerBox = mTexturesUV.texture (widgetTypeState + "c");
+    auto centerBox = sliceTexture (widgetTypeState, "c");
     appendMesh (std::move (centerBox), sf::FloatRect (centerPos, centerSize), horizontal, pMiddle);
   }
 
   // draw right corner with the remaining filling
   const auto pRight = sgui::clamp (0.f, 1.f, (percentToDraw - percentEnd - percentMiddle) / percentEnd);
   if (pRight > 0.01f) {
-    auto rightBox = mTexturesUV.texture (widgetTypeState + "r");
+    auto rightBox = sliceTexture (widgetTypeState, "r");
     appendMesh (std::move (rightBox), sf::FloatRect (rightPos, endSize), horizontal, pRight);
   }
 }
@@ -241,10 +368,10 @@ void GuiRender::addThreeSlices (
 /////////////////////////////////////////////////
 void GuiRender::addNineSlices (
   const sf::FloatRect& box,
-  const std::string& widgetTypeState)
+  std::string_view widgetTypeState)
 {
   // get corner size, we assume that all 4 corner have the same size
-  auto topLeftTexture = mTexturesUV.texture (widgetTypeState + "tl");
+  auto topLeftTexture = sliceTexture (widgetTypeState, "tl");
   const auto textureSize = topLeftTexture[4].texCoords - topLeftTexture[0].texCoords;
   const auto smallestSide = std::min (box.size.x, box.size.y);
   const auto cornerSize = std::min (smallestSide / 2.f, textureSize.x) * sf::Vector2f (1.f, 1.f);
@@ -262,32 +389,32 @@ void GuiRender::addNineSlices (
   appendMesh (std::move (topLeftTexture), topLeft, true);
   // draw top center corner
   const auto topCenter = sf::FloatRect (box.position + cornerSize.x*ux, middleTopSize);
-  appendMesh (mTexturesUV.texture (widgetTypeState + "tc"), topCenter, true);
+  appendMesh (sliceTexture (widgetTypeState, "tc"), topCenter, true);
   // draw top right corner
   const auto topRight = sf::FloatRect (box.position + (cornerSize.x + middleSize.x)*ux, cornerSize);
-  appendMesh (mTexturesUV.texture (widgetTypeState + "tr"), topRight, true);
+  appendMesh (sliceTexture (widgetTypeState, "tr"), topRight, true);
 
   // MIDDLE PART
   // draw center left
   const auto midLeft = sf::FloatRect (box.position + cornerSize.y*uy, middleSideSize);
-  appendMesh (mTexturesUV.texture (widgetTypeState + "ml"), midLeft, true);
+  appendMesh (sliceTexture (widgetTypeState, "ml"), midLeft, true);
   // draw center
   const auto midCenter = sf::FloatRect (box.position + cornerSize, middleSize);
-  appendMesh (mTexturesUV.texture (widgetTypeState + "mc"), midCenter, true);
+  appendMesh (sliceTexture (widgetTypeState, "mc"), midCenter, true);
   // draw center right
   const auto midRight = sf::FloatRect (box.position + cornerSize + middleSize.x*ux, middleSideSize);
-  appendMesh (mTexturesUV.texture (widgetTypeState + "mr"), midRight, true);
+  appendMesh (sliceTexture (widgetTypeState, "mr"), midRight, true);
   
   // BOTTOM PART
   // draw bottom left
   const auto bottomLeft = sf::FloatRect (box.position + (cornerSize.y + middleSize.y)*uy, cornerSize);
-  appendMesh (mTexturesUV.texture (widgetTypeState + "bl"), bottomLeft, true);
+  appendMesh (sliceTexture (widgetTypeState, "bl"), bottomLeft, true);
   // draw bottom
   const auto bottomCenter = sf::FloatRect (box.position + cornerSize + middleSize.y*uy, middleTopSize);
-  appendMesh (mTexturesUV.texture (widgetTypeState + "bc"), bottomCenter, true);
+  appendMesh (sliceTexture (widgetTypeState, "bc"), bottomCenter, true);
   // draw bottom right
   const auto bottomRight = sf::FloatRect (box.position + cornerSize + middleSize, cornerSize);
-  appendMesh (mTexturesUV.texture (widgetTypeState + "br"), bottomRight, true);
+  appendMesh (sliceTexture (widgetTypeState, "br"), bottomRight, true);
 }
 
 /////////////////////////////////////////////////
@@ -310,10 +437,8 @@ void GuiRender::appendMesh (
   }
 
   // append it to active meshes
-  auto& activeMesh = mWidgets.at (clipping.activeLayer ());
-  for (uint32_t i = 0; i < mesh.size (); i++) {
-    activeMesh.append (std::move (mesh [i]));
-  }
+  auto& activeMesh = layer (clipping.activeLayer ()).widgets;
+  activeMesh.insert (std::end (activeMesh), std::begin (mesh), std::end (mesh));
 }
 
 /////////////////////////////////////////////////
@@ -382,10 +507,22 @@ void GuiRender::drawLayer (
   sf::RenderStates states,
   uint32_t layer) const
 {
+  const auto& drawn = mLayers.at (layer);
   target.setView (clipping.at (layer));
-  target.draw (mWidgets.at (layer), states);
-  for (auto text : mTexts.at (layer)) {
-    target.draw (text, states);
+  target.draw (drawn.widgets.data (), drawn.widgets.size (), sf::PrimitiveType::Triangles, states);
+  for (const auto& [texture, mesh] : drawn.images) {
+    auto imageStates = states;
+    imageStates.texture = texture;
+    target.draw (mesh.data (), mesh.size (), sf::PrimitiveType::Triangles, imageStates);
+  }
+  for (uint32_t batch = 0; batch < drawn.glyphsCount; batch++) {
+    auto glyphStates = states;
+    glyphStates.texture = drawn.glyphs [batch].first;
+    const auto& vertices = drawn.glyphs [batch].second;
+    target.draw (vertices.data (), vertices.size (), sf::PrimitiveType::Triangles, glyphStates);
+  }
+  for (uint32_t text = 0; text < drawn.textsCount; text++) {
+    target.draw (drawn.texts [text].text, states);
   }
 }
 
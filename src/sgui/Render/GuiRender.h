@@ -1,6 +1,10 @@
 #pragma once
 
+#include <string>
 #include <vector>
+#include <string_view>
+#include <memory_resource>
+#include <unordered_map>
 #include <SFML/Graphics/Font.hpp>
 #include <SFML/Graphics/View.hpp>
 #include <SFML/Graphics/Text.hpp>
@@ -9,11 +13,13 @@
 #include <SFML/Graphics/Transformable.hpp>
 
 #include "sgui/Core/Shapes.h"
+#include "sgui/Core/FrameArena.h"
 #include "sgui/Render/DrawOptions.h"
 #include "sgui/Render/TextureMeshes.h"
 #include "sgui/Render/MeshFunctions.h"
 #include "sgui/Render/ClippingLayers.h"
 #include "sgui/Resources/TextureAtlas.h"
+#include "sgui/Resources/MappedTextureAtlas.h"
 
 namespace sgui
 {
@@ -45,9 +51,22 @@ public:
    */
   void setTextureAtlas (const TextureAtlas& atlas);
   /**
-   * @brief Clear all widgets and text
+   * @brief Set texture atlas used in render from a binary atlas
+   * @param atlas Texture atlas used
+   */
+  void setTextureAtlas (const MappedTextureAtlas& atlas);
+  /**
+   * @brief Clear all widgets and text. Meshes and texts of layers are kept
+   *   and reused by the next frame, so a fixed UI doesn't allocate once warmed up.
    */
   void clear ();
+  /**
+   * @brief Set resource used by meshes, batches and names of a frame. They are
+   *   dropped without allocating, so the resource can be reset right after.
+   *   Texts are kept on the heap, as sf::Text doesn't use the resource.
+   * @param resource Memory resource for frame containers
+   */
+  void setMemoryResource (std::pmr::memory_resource* resource);
   /**
    * @brief interface to draw Gui standard element
    * @param box Rect of the widget to draw
@@ -63,18 +82,39 @@ public:
    * @param options Contains font size, color and positions of text 
    */
   void draw (
-      const std::string& text,
+      std::string_view text,
       const sf::Font& font,
       const TextDrawOptions& options = {});
   /**
-   * @brief Get text size as if it was drawn on screen
+   * @brief interface to draw a whole texture stretched in a box. It's drawn
+   *   over the widgets of the active clipping layer, with a single quad.
+   * @param box Rect in which the texture is drawn
+   * @param texture Texture to draw, it must live until the end of the frame
+   */
+  void draw (
+      const sf::FloatRect& box,
+      const sf::Texture& texture);
+  /**
+   * @brief interface to draw glyphs or lines already laid out, as triangles
+   *   textured with a font texture. Consecutive calls with the same texture
+   *   are merged in a single batch of the active clipping layer.
+   * @param vertices Triangles to draw, texture coordinates are in pixels
+   * @param texture Texture of the triangles, it must live until the end of the frame
+   * @param offset Translation applied to vertices
+   */
+  void draw (
+      const std::vector<sf::Vertex>& vertices,
+      const sf::Texture& texture,
+      const sf::Vector2f& offset = {});
+  /**
+   * @brief Get text size as if it was drawn on screen, sizes are cached
    * @param text Text from which we want the size
    * @param font Font of the text
    * @param fontSize Size of the text font
    * @return Size of the text as it would be displayed
    */
   sf::Vector2f textSize (
-      const std::string& text,
+      std::string_view text,
       const sf::Font& font,
       const uint32_t fontSize) const;
   /**
@@ -105,12 +145,12 @@ private:
    * to draw slider, title box, etc. i.e. widget that posses
    * 2 corner with fixed size and a stretched center patch
    */
-  void addThreeSlices (const sf::FloatRect& box, const std::string& widgetState, const bool horizontal = true, const float percentToDraw = 1.f);
+  void addThreeSlices (const sf::FloatRect& box, std::string_view widgetState, const bool horizontal = true, const float percentToDraw = 1.f);
   /**
    * to draw window box, panel box, etc. with 4 corner
    * with fixed size and 5 stretched center patch
    */
-  void addNineSlices (const sf::FloatRect& box, const std::string& widgetState);
+  void addNineSlices (const sf::FloatRect& box, std::string_view widgetState);
   /**
    * add mesh to the draw batch
    */
@@ -127,22 +167,71 @@ private:
    * to avoid duplications
    */
   void drawLayer (sf::RenderTarget& target, sf::RenderStates states, uint32_t layer) const;
+  /**
+   * to get texture of a slice, name is built in a reused buffer
+   */
+  Mesh sliceTexture (std::string_view widgetState, std::string_view slice) const;
+  /**
+   * to get layer meshes, layers are created on first use
+   */
+  struct Layer;
+  Layer& layer (const uint32_t index);
   /**
    * to convert type to name
    */
-  std::string toString (const Widget widget) const;
-  std::string toString (const ItemState state) const;
+  std::string_view toString (const Widget widget) const;
+  std::string_view toString (const ItemState state) const;
+private:
+  /**
+   * text drawn in a layer, its utf8 string is kept to skip
+   * conversion when the same text is drawn again
+   */
+  struct CachedText {
+    explicit CachedText (const sf::Font& textFont) : font (&textFont), text (textFont) {}
+    const sf::Font* font = nullptr;
+    std::string utf8 = "";
+    sf::Text text;
+  };
+  /**
+   * meshes of a clipping layer, with count of used batches and texts
+   */
+  struct Layer {
+    explicit Layer (std::pmr::memory_resource* resource)
+      : widgets (resource), images (resource), glyphs (resource) {}
+    std::pmr::vector <sf::Vertex> widgets;
+    std::pmr::vector <std::pair <const sf::Texture*, Mesh>> images;
+    std::pmr::vector <std::pair <const sf::Texture*, std::pmr::vector <sf::Vertex>>> glyphs;
+    std::vector <CachedText> texts;
+    uint32_t glyphsCount = 0u;
+    uint32_t textsCount = 0u;
+  };
+  /**
+   * measured text, its key is kept to check it on a hit of its hash
+   */
+  struct TextSize {
+    std::string text = "";
+    const sf::Font* font = nullptr;
+    uint32_t fontSize = 0u;
+    sf::Vector2f size = {};
+  };
+  // maximum number of text sizes kept in cache
+  static constexpr size_t TextSizesCacheSize = 4096u;
 private:
   // define on which render we work
   bool mTooltipMode;
-  std::vector <uint32_t> mWidgetLayers;
-  std::vector <uint32_t> mTooltipLayers;
+  std::pmr::memory_resource* mResource = std::pmr::get_default_resource ();
+  std::pmr::vector <uint32_t> mWidgetLayers;
+  std::pmr::vector <uint32_t> mTooltipLayers;
   // font and texture
   sf::Texture* mGuiTexture;
-  // widget mesh
-  std::vector <sf::VertexArray> mWidgets;
-  std::vector <std::vector <sf::Text>> mTexts;
+  // widget mesh, layers after mLayersCount are unused and kept for next frames
+  uint32_t mLayersCount = 0u;
+  std::vector <Layer> mLayers;
   TextureMeshes mTexturesUV;
+  std::pmr::string mWidgetState;
+  mutable std::pmr::string mTextureName;
+  // text sizes, by hash of text, font and size
+  mutable std::unordered_map <size_t, TextSize> mTextSizes;
 };
 
 } // namespace sgui
@@ -0,0 +1,224 @@
+#include <cstring>
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+#include "sgui/Core/Interpolation.h"
+#include "sgui/Render/Heatmap.h"
+
+namespace sgui
+{
+/////////////////////////////////////////////////
+Heatmap::Heatmap ()
+{
+  // viridis like color map
+  setColorMap ({
+    sf::Color (68, 1, 84),
+    sf::Color (59, 82, 139),
+    sf::Color (33, 145, 140),
+    sf::Color (94, 201, 98),
+    sf::Color (253, 231, 37)
+  });
+}
+
+/////////////////////////////////////////////////
+Heatmap::Heatmap (const sf::Vector2u& gridSize)
+  : Heatmap ()
+{
+  resize (gridSize);
+}
+
+/////////////////////////////////////////////////
+void Heatmap::resize (const sf::Vector2u& gridSize)
+{
+  mSize = gridSize;
+  if (mSize.x == 0 || mSize.y == 0) {
+    mPixels.clear ();
+    mChanged = false;
+    return;
+  }
+  if (!mTexture.resize (mSize)) {
+    spdlog::error ("Heatmap::resize, unable to create a {}x{} texture", mSize.x, mSize.y);
+  }
+  // fill with minimum color and upload everything
+  const auto color = mColorMap.front ();
+  mPixels.resize (4 * static_cast<size_t> (mSize.x) * mSize.y);
+  for (size_t i = 0; i < mPixels.size (); i += 4) {
+    mPixels [i] = color.r;
+    mPixels [i + 1] = color.g;
+    mPixels [i + 2] = color.b;
+    mPixels [i + 3] = color.a;
+  }
+  markChanged ({0, 0}, {mSize.x - 1, mSize.y - 1});
+}
+
+/////////////////////////////////////////////////
+sf::Vector2u Heatmap::size () const
+{
+  return mSize;
+}
+
+/////////////////////////////////////////////////
+void Heatmap::setRange (const float min, const float max)
+{
+  mMin = min;
+  mMax = max;
+}
+
+/////////////////////////////////////////////////
+void Heatmap::setColorMap (const std::vector<sf::Color>& stops)
+{
+  if (stops.empty ()) {
+    spdlog::warn ("Heatmap::setColorMap, color map need at least one color");
+    return;
+  }
+  if (stops.size () == 1) {
+    mColorMap.fill (stops.front ());
+    return;
+  }
+  // interpolate between the two stops around each entry
+  const auto intervals = static_cast<float> (stops.size () - 1);
+  for (uint32_t i = 0; i < ColorMapSize; i++) {
+    const auto t = intervals * i / static_cast<float> (ColorMapSize - 1);
+    const auto stop = std::min (static_cast<size_t> (t), stops.size () - 2);
+    mColorMap [i] = lerp (stops [stop], stops [stop + 1], t - stop);
+  }
+}
+
+/////////////////////////////////////////////////
+void Heatmap::set (const std::vector<float>& values)
+{
+  const auto count = static_cast<size_t> (mSize.x) * mSize.y;
+  if (values.size () < count) {
+    spdlog::warn ("Heatmap::set, {} values for a grid of {} cells", values.size (), count);
+    return;
+  }
+  for (uint32_t y = 0; y < mSize.y; y++) {
+    for (uint32_t x = 0; x < mSize.x; x++) {
+      setPixel (x, y, values [static_cast<size_t> (y) * mSize.x + x]);
+    }
+  }
+  if (count > 0) {
+    markChanged ({0, 0}, {mSize.x - 1, mSize.y - 1});
+  }
+}
+
+/////////////////////////////////////////////////
+void Heatmap::set (
+  const sf::Vector2u& cell,
+  const float value)
+{
+  if (cell.x >= mSize.x || cell.y >= mSize.y) {
+    spdlog::warn ("Heatmap::set, cell ({}, {}) is outside of the grid", cell.x, cell.y);
+    return;
+  }
+  setPixel (cell.x, cell.y, value);
+  markChanged (cell, cell);
+}
+
+/////////////////////////////////////////////////
+void Heatmap::setRow (
+  const uint32_t row,
+  const float* values)
+{
+  if (row >= mSize.y) {
+    spdlog::warn ("Heatmap::setRow, row {} is outside of the grid", row);
+    return;
+  }
+  for (uint32_t x = 0; x < mSize.x; x++) {
+    setPixel (x, row, values [x]);
+  }
+  markChanged ({0, row}, {mSize.x - 1, row});
+}
+
+/////////////////////////////////////////////////
+void Heatmap::setColumn (
+  const uint32_t column,
+  const float* values)
+{
+  if (column >= mSize.x) {
+    spdlog::warn ("Heatmap::setColumn, column {} is outside of the grid", column);
+    return;
+  }
+  for (uint32_t y = 0; y < mSize.y; y++) {
+    setPixel (column, y, values [y]);
+  }
+  markChanged ({column, 0}, {column, mSize.y - 1});
+}
+
+/////////////////////////////////////////////////
+void Heatmap::update ()
+{
+  if (!mChanged) {
+    return;
+  }
+  mChanged = false;
+
+  // full rows are contiguous in the pixel buffer and can be sent directly
+  const auto area = mChangedMax - mChangedMin + sf::Vector2u (1, 1);
+  const auto rowBytes = 4 * static_cast<size_t> (mSize.x);
+  if (area.x == mSize.x) {
+    mTexture.update (mPixels.data () + mChangedMin.y * rowBytes, area, mChangedMin);
+    return;
+  }
+
+  // otherwise changed area is packed before being sent
+  const auto areaBytes = 4 * static_cast<size_t> (area.x);
+  mUpload.resize (areaBytes * area.y);
+  for (uint32_t y = 0; y < area.y; y++) {
+    const auto* source = mPixels.data () + (mChangedMin.y + y) * rowBytes + 4 * static_cast<size_t> (mChangedMin.x);
+    std::memcpy (mUpload.data () + y * areaBytes, source, areaBytes);
+  }
+  mTexture.update (mUpload.data (), area, mChangedMin);
+}
+
+/////////////////////////////////////////////////
+const sf::Texture& Heatmap::texture () const
+{
+  return mTexture;
+}
+
+/////////////////////////////////////////////////
+sf::Color Heatmap::toColor (const float value) const
+{
+  // nan are mapped to the minimum
+  auto t = (value - mMin) / (mMax - mMin);
+  if (!(t > 0.f)) {
+    t = 0.f;
+  }
+  t = std::min (t, 1.f);
+  const auto index = std::min (static_cast<uint32_t> (t * (ColorMapSize - 1) + 0.5f), ColorMapSize - 1);
+  return mColorMap [index];
+}
+
+/////////////////////////////////////////////////
+void Heatmap::setPixel (
+  const uint32_t x,
+  const uint32_t y,
+  const float value)
+{
+  const auto color = toColor (value);
+  auto* pixel = mPixels.data () + 4 * (static_cast<size_t> (y) * mSize.x + x);
+  pixel [0] = color.r;
+  pixel [1] = color.g;
+  pixel [2] = color.b;
+  pixel [3] = color.a;
+}
+
+/////////////////////////////////////////////////
+void Heatmap::markChanged (
+  const sf::Vector2u& first,
+  const sf::Vector2u& last)
+{
+  if (!mChanged) {
+    mChangedMin = first;
+    mChangedMax = last;
+    mChanged = true;
+    return;
+  }
+  mChangedMin.x = std::min (mChangedMin.x, first.x);
+  mChangedMin.y = std::min (mChangedMin.y, first.y);
+  mChangedMax.x = std::max (mChangedMax.x, last.x);
+  mChangedMax.y = std::max (mChangedMax.y, last.y);
+}
+
+} // namespace sgui
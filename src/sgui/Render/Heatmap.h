@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+namespace sgui
+{
+/**
+ * @brief grid of values displayed as an image. Values are mapped through a
+ *   color lookup table into a texture owned by the heatmap. Only the cells
+ *   changed since the last update are uploaded, as a single sub-rectangle.
+ */
+class Heatmap
+{
+public:
+  /**
+   * @brief number of entries in the color lookup table
+   */
+  static constexpr uint32_t ColorMapSize = 256;
+  /**
+   * @brief create an empty heatmap with a default color map
+   */
+  Heatmap ();
+  /**
+   * @brief create a heatmap of a given grid size
+   * @param gridSize is the number of columns and rows of the grid
+   */
+  explicit Heatmap (const sf::Vector2u& gridSize);
+  /**
+   * @brief change grid size, all values are reset to the minimum
+   */
+  void resize (const sf::Vector2u& gridSize);
+  /**
+   * @brief get grid size
+   */
+  sf::Vector2u size () const;
+  /**
+   * @brief set values mapped to the first and the last color of the map.
+   *   Already set values are not re-mapped.
+   */
+  void setRange (const float min, const float max);
+  /**
+   * @brief set color map, colors are interpolated regularly between stops
+   * @param stops are the colors from the minimum to the maximum of the range
+   */
+  void setColorMap (const std::vector<sf::Color>& stops);
+  /**
+   * @brief set all values, stored row after row
+   */
+  void set (const std::vector<float>& values);
+  /**
+   * @brief set a single value
+   */
+  void set (const sf::Vector2u& cell, const float value);
+  /**
+   * @brief set values of a row, from its first column
+   * @param values must hold at least size ().x values
+   */
+  void setRow (const uint32_t row, const float* values);
+  /**
+   * @brief set values of a column, from its first row
+   * @param values must hold at least size ().y values
+   */
+  void setColumn (const uint32_t column, const float* values);
+  /**
+   * @brief upload changed cells in the texture
+   */
+  void update ();
+  /**
+   * @brief get texture, call update before to get it up to date
+   */
+  const sf::Texture& texture () const;
+private:
+  // map value to a color
+  sf::Color toColor (const float value) const;
+  // write a color in the pixel buffer
+  void setPixel (const uint32_t x, const uint32_t y, const float value);
+  // extend changed area
+  void markChanged (const sf::Vector2u& first, const sf::Vector2u& last);
+private:
+  sf::Vector2u mSize = {};
+  float mMin = 0.f;
+  float mMax = 1.f;
+  std::array<sf::Color, ColorMapSize> mColorMap;
+  std::vector<uint8_t> mPixels;
+  std::vector<uint8_t> mUpload;
+  sf::Texture mTexture;
+  bool mChanged = false;
+  sf::Vector2u mChangedMin = {};
+  sf::Vector2u mChangedMax = {};
+};
+
+} // namespace sgui
@@ -0,0 +1,230 @@
+#include <cmath>
+#include <algorithm>
+#include "sgui/Render/LineKernels.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define SGUI_SSE2
+  #include <emmintrin.h>
+#endif
+
+namespace sgui
+{
+/////////////////////////////////////////////////
+void PolylineBuffer::resize (const size_t count)
+{
+  directionX.resize (count);
+  directionY.resize (count);
+  normalX.resize (count);
+  normalY.resize (count);
+  leftX.resize (count);
+  leftY.resize (count);
+  rightX.resize (count);
+  rightY.resize (count);
+}
+
+namespace
+{
+/////////////////////////////////////////////////
+// scalar kernels, they define the reference result
+/////////////////////////////////////////////////
+float remapValue (
+  const AxisRemap& axis,
+  const float range,
+  const float value)
+{
+  if (!axis.enabled) {
+    return value + axis.offset;
+  }
+  const auto input = axis.flip ? -value : value;
+  const auto t = std::min (1.f, std::max ((input - axis.inputMin) / range, 0.f));
+  return std::min (axis.outputMax, std::max (t * axis.outputMax, 0.f)) + axis.offset;
+}
+
+/////////////////////////////////////////////////
+void normalize (
+  const float x,
+  const float y,
+  float& outX,
+  float& outY)
+{
+  const auto length = std::sqrt (x*x + y*y);
+  outX = x / length;
+  outY = y / length;
+}
+
+#ifdef SGUI_SSE2
+/////////////////////////////////////////////////
+// sse2 kernels, same operations as their scalar counterpart
+/////////////////////////////////////////////////
+__m128 remapValues (
+  const AxisRemap& axis,
+  const float range,
+  __m128 value)
+{
+  if (!axis.enabled) {
+    return _mm_add_ps (value, _mm_set1_ps (axis.offset));
+  }
+  if (axis.flip) {
+    value = _mm_xor_ps (value, _mm_set1_ps (-0.f));
+  }
+  // _mm_max_ps (a, b) and _mm_min_ps (a, b) return b when a compare false,
+  // operands are ordered to match std::max and std::min with nan
+  const auto output = _mm_set1_ps (axis.outputMax);
+  const auto ratio = _mm_div_ps (_mm_sub_ps (value, _mm_set1_ps (axis.inputMin)), _mm_set1_ps (range));
+  const auto t = _mm_min_ps (_mm_max_ps (_mm_setzero_ps (), ratio), _mm_set1_ps (1.f));
+  const auto mapped = _mm_min_ps (_mm_max_ps (_mm_setzero_ps (), _mm_mul_ps (t, output)), output);
+  return _mm_add_ps (mapped, _mm_set1_ps (axis.offset));
+}
+
+/////////////////////////////////////////////////
+void normalize (
+  const __m128 x,
+  const __m128 y,
+  __m128& outX,
+  __m128& outY)
+{
+  const auto length = _mm_sqrt_ps (_mm_add_ps (_mm_mul_ps (x, x), _mm_mul_ps (y, y)));
+  outX = _mm_div_ps (x, length);
+  outY = _mm_div_ps (y, length);
+}
+#endif
+
+} // namespace
+
+/////////////////////////////////////////////////
+void Kernels::remapPoints (
+  const sf::Vector2f* points,
+  const size_t count,
+  const AxisRemap& xAxis,
+  const AxisRemap& yAxis,
+  float* x,
+  float* y)
+{
+  const auto xRange = xAxis.inputMax - xAxis.inputMin;
+  const auto yRange = yAxis.inputMax - yAxis.inputMin;
+  auto i = size_t (0);
+#ifdef SGUI_SSE2
+  // points are packed as x0 y0 x1 y1..., deinterleave them four by four
+  const auto* packed = reinterpret_cast<const float*> (points);
+  for (; i + 4 <= count; i += 4) {
+    const auto low = _mm_loadu_ps (packed + 2*i);
+    const auto high = _mm_loadu_ps (packed + 2*i + 4);
+    const auto px = _mm_shuffle_ps (low, high, _MM_SHUFFLE (2, 0, 2, 0));
+    const auto py = _mm_shuffle_ps (low, high, _MM_SHUFFLE (3, 1, 3, 1));
+    _mm_storeu_ps (x + i, remapValues (xAxis, xRange, px));
+    _mm_storeu_ps (y + i, remapValues (yAxis, yRange, py));
+  }
+#endif
+  for (; i < count; i++) {
+    x [i] = remapValue (xAxis, xRange, points [i].x);
+    y [i] = remapValue (yAxis, yRange, points [i].y);
+  }
+}
+
+/////////////////////////////////////////////////
+void Kernels::remapAxis (
+  const float* values,
+  const size_t count,
+  const AxisRemap& axis,
+  float* output)
+{
+  const auto range = axis.inputMax - axis.inputMin;
+  auto i = size_t (0);
+#ifdef SGUI_SSE2
+  for (; i + 4 <= count; i += 4) {
+    _mm_storeu_ps (output + i, remapValues (axis, range, _mm_loadu_ps (values + i)));
+  }
+#endif
+  for (; i < count; i++) {
+    output [i] = remapValue (axis, range, values [i]);
+  }
+}
+
+/////////////////////////////////////////////////
+void Kernels::lineDirections (
+  const float* x,
+  const float* y,
+  const size_t count,
+  float* directionX,
+  float* directionY)
+{
+  const auto lines = count > 0 ? count - 1 : 0;
+  auto i = size_t (0);
+#ifdef SGUI_SSE2
+  for (; i + 4 <= lines; i += 4) {
+    const auto dx = _mm_sub_ps (_mm_loadu_ps (x + i + 1), _mm_loadu_ps (x + i));
+    const auto dy = _mm_sub_ps (_mm_loadu_ps (y + i + 1), _mm_loadu_ps (y + i));
+    auto ux = __m128 ();
+    auto uy = __m128 ();
+    normalize (dx, dy, ux, uy);
+    _mm_storeu_ps (directionX + i, ux);
+    _mm_storeu_ps (directionY + i, uy);
+  }
+#endif
+  for (; i < lines; i++) {
+    normalize (x [i + 1] - x [i], y [i + 1] - y [i], directionX [i], directionY [i]);
+  }
+}
+
+/////////////////////////////////////////////////
+void Kernels::miterNormals (
+  const float* directionX,
+  const float* directionY,
+  const size_t count,
+  float* normalX,
+  float* normalY)
+{
+  // normal at point i join line i - 1 and line i
+  const auto last = count > 0 ? count - 1 : 0;
+  auto i = size_t (1);
+#ifdef SGUI_SSE2
+  for (; i + 4 <= last; i += 4) {
+    const auto sumX = _mm_add_ps (_mm_loadu_ps (directionX + i - 1), _mm_loadu_ps (directionX + i));
+    const auto sumY = _mm_add_ps (_mm_loadu_ps (directionY + i - 1), _mm_loadu_ps (directionY + i));
+    // perpendicular of (x, y) is (-y, x)
+    const auto perpendicularX = _mm_xor_ps (sumY, _mm_set1_ps (-0.f));
+    auto nx = __m128 ();
+    auto ny = __m128 ();
+    normalize (perpendicularX, sumX, nx, ny);
+    _mm_storeu_ps (normalX + i, nx);
+    _mm_storeu_ps (normalY + i, ny);
+  }
+#endif
+  for (; i < last; i++) {
+    const auto sumX = directionX [i - 1] + directionX [i];
+    const auto sumY = directionY [i - 1] + directionY [i];
+    normalize (-sumY, sumX, normalX [i], normalY [i]);
+  }
+}
+
+/////////////////////////////////////////////////
+void Kernels::extrude (
+  const float* x,
+  const float* y,
+  const float* normalX,
+  const float* normalY,
+  const size_t count,
+  const float thick,
+  const sf::Vector2f& offset,
+  float* outX,
+  float* outY)
+{
+  auto i = size_t (0);
+#ifdef SGUI_SSE2
+  const auto thickness = _mm_set1_ps (thick);
+  const auto offsetX = _mm_set1_ps (offset.x);
+  const auto offsetY = _mm_set1_ps (offset.y);
+  for (; i + 4 <= count; i += 4) {
+    const auto px = _mm_add_ps (_mm_loadu_ps (x + i), _mm_mul_ps (thickness, _mm_loadu_ps (normalX + i)));
+    const auto py = _mm_add_ps (_mm_loadu_ps (y + i), _mm_mul_ps (thickness, _mm_loadu_ps (normalY + i)));
+    _mm_storeu_ps (outX + i, _mm_add_ps (px, offsetX));
+    _mm_storeu_ps (outY + i, _mm_add_ps (py, offsetY));
+  }
+#endif
+  for (; i < count; i++) {
+    outX [i] = (x [i] + thick * normalX [i]) + offset.x;
+    outY [i] = (y [i] + thick * normalY [i]) + offset.y;
+  }
+}
+
+} // namespace sgui
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <SFML/System/Vector2.hpp>
+
+namespace sgui
+{
+/**
+ * @brief affine map of an axis, value is sent from [inputMin, inputMax] to
+ *   [0, outputMax] with clamping, as sgui::remap does, then shifted by offset.
+ *   If flip is set, -value is remapped instead of value.
+ */
+struct AxisRemap {
+  bool enabled = true;
+  bool flip = false;
+  float inputMin = 0.f;
+  float inputMax = 1.f;
+  float outputMax = 1.f;
+  float offset = 0.f;
+};
+
+/**
+ * @brief scratch arrays used to extrude a polyline, stored as structure of arrays
+ */
+struct PolylineBuffer {
+  void resize (const size_t count);
+  std::vector<float> directionX;
+  std::vector<float> directionY;
+  std::vector<float> normalX;
+  std::vector<float> normalY;
+  std::vector<float> leftX;
+  std::vector<float> leftY;
+  std::vector<float> rightX;
+  std::vector<float> rightY;
+};
+
+/**
+ * @brief batch kernels used to transform and tessellate polylines. They are
+ *   vectorised with SSE2 when available, the scalar fallback perform the same
+ *   operations in the same order and give bitwise identical results.
+ */
+namespace Kernels
+{
+  /**
+   * @brief remap points and store them as separate x and y arrays
+   */
+  void remapPoints (
+         const sf::Vector2f* points,
+         const size_t count,
+         const AxisRemap& xAxis,
+         const AxisRemap& yAxis,
+         float* x,
+         float* y);
+  /**
+   * @brief remap values of a single axis
+   */
+  void remapAxis (
+         const float* values,
+         const size_t count,
+         const AxisRemap& axis,
+         float* output);
+  /**
+   * @brief compute unit direction of each of the count - 1 lines of a polyline
+   */
+  void lineDirections (
+         const float* x,
+         const float* y,
+         const size_t count,
+         float* directionX,
+         float* directionY);
+  /**
+   * @brief compute unit normal at each inner point of a polyline, as the
+   *   normal of the sum of the directions of the lines joined at that point.
+   *   Normals of the first and last points are left untouched.
+   */
+  void miterNormals (
+         const float* directionX,
+         const float* directionY,
+         const size_t count,
+         float* normalX,
+         float* normalY);
+  /**
+   * @brief move points along their normal by thick, then shift them by offset.
+   */
+  void extrude (
+         const float* x,
+         const float* y,
+         const float* normalX,
+         const float* normalY,
+         const size_t count,
+         const float thick,
+         const sf::Vector2f& offset,
+         float* outX,
+         float* outY);
+} // namespace Kernels
+
+} // namespace sgui
@@ -1,5 +1,9 @@
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
 #include "sgui/Render/Plotter.h"
 #include "sgui/Core/Interpolation.h"
+#include "sgui/Render/SeriesPyramid.h"
 
 namespace sgui
 {
@@ -9,6 +13,12 @@ void Plotter::setSample (const uint32_t sample)
   mSample = sample;
 }
 
+/////////////////////////////////////////////////
+void Plotter::setWorkers (ThreadPool* workers)
+{
+  mWorkers = workers;
+}
+
 /////////////////////////////////////////////////
 void Plotter::unsetBound ()
 {
@@ -46,6 +56,16 @@ void Plotter::clear ()
   render.clear ();
 }
 
+/////////////////////////////////////////////////
+void Plotter::setMemoryResource (std::pmr::memory_resource* resource)
+{
+  render.setMemoryResource (resource);
+  rebindResource (mPlotX, resource);
+  rebindResource (mPlotY, resource);
+  rebindResource (mGridX, resource);
+  rebindResource (mSeriesY, resource);
+}
+
 /////////////////////////////////////////////////
 void Plotter::plot (
   const std::function<float (float)>& slope,
@@ -53,25 +73,32 @@ void Plotter::plot (
   const sf::Color& lineColor,
   const float thickness)
 {
-  // draw n=sample lines with the wanted slope
-  const auto max = static_cast<float> (mSample);
+  plotSampled (slope, position, lineColor, thickness);
+}
 
-  // we use int to avoid dubious bug with i-1
-  for (int i = 0; i < static_cast<int>(mSample); i++) {
-    const auto xA = lerp (xRange.min, xRange.max, i / max);
-    const auto xB = lerp (xRange.min, xRange.max, (i + 1) / max);
-    const auto xPrev = lerp (xRange.min, xRange.max, (i - 1) / max);
-    const auto xNext = lerp (xRange.min, xRange.max, (i + 2) / max);
-    const auto a = position + toPlot (xA, slope (xA));
-    const auto b = position + toPlot (xB, slope (xB));
-    render.loadConnected (
-      LineFloat (a, b),
-      position + toPlot (xPrev, slope (xPrev)),
-      position + toPlot (xNext, slope (xNext)),
-      thickness,
-      lineColor
-    );
-  }
+/////////////////////////////////////////////////
+void Plotter::plot (
+  const std::function<sf::Vector2f (float)>& slope,
+  const sf::Vector2f& position,
+  const sf::Color& lineColor,
+  const float thickness)
+{
+  plotSampled (slope, position, lineColor, thickness);
+}
+
+/////////////////////////////////////////////////
+void Plotter::plot (
+  const std::vector<sf::Vector2f>& points,
+  const sf::Vector2f& position,
+  const sf::Color& lineColor,
+  const float thickness)
+{
+  // remap all points in the draw area, then tessellate them in one batch
+  const auto count = points.size ();
+  mPlotX.resize (count);
+  mPlotY.resize (count);
+  Kernels::remapPoints (points.data (), count, xAxisRemap (position), yAxisRemap (position), mPlotX.data (), mPlotY.data ());
+  render.loadConnectedLines (mPlotX.data (), mPlotY.data (), count, thickness, lineColor);
 
   // draw border and axis on top
   if (mBounded) {
@@ -81,27 +108,96 @@ void Plotter::plot (
 
 /////////////////////////////////////////////////
 void Plotter::plot (
-  const std::function<sf::Vector2f (float)>& slope,
+  const SeriesPyramid& series,
   const sf::Vector2f& position,
   const sf::Color& lineColor,
   const float thickness)
 {
-  // draw n=sample lines with the wanted slope
+  // one column per pixel, or the requested sample when the plot has no width
+  const auto pixels = mBounded ? static_cast<uint32_t> (std::max (mBound.x, 1.f)) : std::max (mSample, 1u);
+  series.sample (xRange, pixels, mPoints);
+  plot (mPoints, position, lineColor, thickness);
+}
+
+/////////////////////////////////////////////////
+void Plotter::plot (
+  const std::vector<sf::Vector2f>& points,
+  const sf::Vector2f& position,
+  const sf::Color& lineColor,
+  const float thickness,
+  const PlotCache& cache)
+{
+  if (loadCachedGeometry (cache, position, lineColor, thickness)) {
+    return;
+  }
+  const auto firstVertex = render.vertexCount ();
+  plot (points, position, lineColor, thickness);
+  cacheGeometry (cache, position, lineColor, thickness, firstVertex);
+}
+
+/////////////////////////////////////////////////
+void Plotter::plot (
+  const SeriesPyramid& series,
+  const sf::Vector2f& position,
+  const sf::Color& lineColor,
+  const float thickness,
+  const PlotCache& cache)
+{
+  // sampling is skipped too, as it only depends on data and ranges
+  if (loadCachedGeometry (cache, position, lineColor, thickness)) {
+    return;
+  }
+  const auto firstVertex = render.vertexCount ();
+  plot (series, position, lineColor, thickness);
+  cacheGeometry (cache, position, lineColor, thickness, firstVertex);
+}
+
+/////////////////////////////////////////////////
+void Plotter::plot (
+  const std::vector<PlotSeries>& series,
+  const sf::Vector2f& position)
+{
+  // shared x grid, with one more point on each side to orient line ends
+  const auto count = static_cast<size_t> (mSample) + 3;
   const auto max = static_cast<float> (mSample);
+  mGridX.resize (count);
+  for (size_t k = 0; k < count; k++) {
+    mGridX [k] = lerp (xRange.min, xRange.max, (static_cast<int> (k) - 1) / max);
+  }
+  mPlotX.resize (count);
+  Kernels::remapAxis (mGridX.data (), count, xAxisRemap (position), mPlotX.data ());
 
-  // we use int to avoid dubious bug with i-1
-  for (int i = 0; i < static_cast<int>(mSample); i++) {
-    const auto a = slope (lerp (xRange.min, xRange.max, i / max));
-    const auto b = slope (lerp (xRange.min, xRange.max, (i + 1) / max));
-    const auto prev = slope (lerp (xRange.min, xRange.max, (i - 1) / max));
-    const auto next = slope (lerp (xRange.min, xRange.max, (i + 2) / max));
-    render.loadConnected (
-      LineFloat (position + toPlot (a), position + toPlot (b)),
-      position + toPlot (prev),
-      position + toPlot (next),
-      thickness,
-      lineColor
-    );
+  // get y of each series on the grid, then remap and tessellate it
+  const auto yAxis = yAxisRemap (position);
+  mSeriesY.resize (count);
+  mPlotY.resize (count);
+  for (const auto& curve : series) {
+    if (curve.values) {
+      const auto& values = *curve.values;
+      if (values.size () != count - 2 || values.size () < 2) {
+        spdlog::warn ("Plotter::plot, series of {} values doesn't match grid of {} points", values.size (), count - 2);
+        continue;
+      }
+      // guide points extend first and last lines
+      std::copy (values.begin (), values.end (), mSeriesY.begin () + 1);
+      mSeriesY.front () = 2.f * values [0] - values [1];
+      mSeriesY.back () = 2.f * values [count - 3] - values [count - 4];
+    } else if (curve.slope) {
+      const auto sampleChunk = [this, &curve] (const size_t begin, const size_t end) {
+        for (auto k = begin; k < end; k++) {
+          mSeriesY [k] = curve.slope (mGridX [k]);
+        }
+      };
+      if (mWorkers && count > 256) {
+        mWorkers->parallelFor (count, sampleChunk, 256);
+      } else {
+        sampleChunk (0, count);
+      }
+    } else {
+      continue;
+    }
+    Kernels::remapAxis (mSeriesY.data (), count, yAxis, mPlotY.data ());
+    render.loadConnectedLines (mPlotX.data (), mPlotY.data (), count, curve.thickness, curve.color);
   }
 
   // draw border and axis on top
@@ -112,49 +208,111 @@ void Plotter::plot (
 
 /////////////////////////////////////////////////
 void Plotter::plot (
-  const std::vector<sf::Vector2f>& points,
+  const std::vector<PlotSeries>& series,
   const sf::Vector2f& position,
-  const sf::Color& lineColor,
-  const float thickness)
+  const PlotCache& cache)
 {
-  // we use int to avoid dubious bug with i-1
-  for (uint32_t i = 1; i < points.size () - 2; i++) {
-    const auto a = points[i];
-    const auto b = points[i + 1];
-    const auto prev = points[i - 1];
-    const auto next = points[i + 2];
-    render.loadConnected (
-      LineFloat (position + toPlot (a), position + toPlot (b)),
-      position + toPlot (prev),
-      position + toPlot (next),
-      thickness,
-      lineColor
-    );
+  // colors and thickness are part of the version
+  if (loadCachedGeometry (cache, position, sf::Color::Transparent, 0.f)) {
+    return;
   }
+  const auto firstVertex = render.vertexCount ();
+  plot (series, position);
+  cacheGeometry (cache, position, sf::Color::Transparent, 0.f, firstVertex);
+}
 
-  // draw border and axis on top
-  if (mBounded) {
-    drawBorderAndAxes (position);
-  }
+/////////////////////////////////////////////////
+void Plotter::clearCache ()
+{
+  mGeometries.clear ();
 }
 
 /////////////////////////////////////////////////
-sf::Vector2f Plotter::toPlot (
-  const float pointX,
-  const float pointY) const
+AxisRemap Plotter::xAxisRemap (const sf::Vector2f& position) const
 {
-  if (mBounded) {
-    const auto x = remap (xRange.min, xRange.max, 0.f, mBound.x, pointX);
-    const auto y = remap (-yRange.max, -yRange.min, 0.f, mBound.y, -pointY);
-    return sf::Vector2f (x, y);
+  auto axis = AxisRemap ();
+  axis.enabled = mBounded;
+  axis.inputMin = xRange.min;
+  axis.inputMax = xRange.max;
+  axis.outputMax = mBound.x;
+  axis.offset = position.x;
+  return axis;
+}
+
+/////////////////////////////////////////////////
+AxisRemap Plotter::yAxisRemap (const sf::Vector2f& position) const
+{
+  // y axis is flipped as it goes down on screen
+  auto axis = AxisRemap ();
+  axis.enabled = mBounded;
+  axis.flip = true;
+  axis.inputMin = -yRange.max;
+  axis.inputMax = -yRange.min;
+  axis.outputMax = mBound.y;
+  axis.offset = position.y;
+  return axis;
+}
+
+/////////////////////////////////////////////////
+bool Plotter::loadCachedGeometry (
+  const PlotCache& cache,
+  const sf::Vector2f& position,
+  const sf::Color& lineColor,
+  const float thickness)
+{
+  if (!mGeometries.has (cache.id)) {
+    return false;
   }
-  return sf::Vector2f (pointX, pointY);
+
+  // every setting that change vertices invalidate the geometry
+  const auto& geometry = mGeometries.get (cache.id);
+  const auto isValid = geometry.version == cache.version
+    && geometry.source == cache.source
+    && geometry.xRange.min == xRange.min
+    && geometry.xRange.max == xRange.max
+    && geometry.yRange.min == yRange.min
+    && geometry.yRange.max == yRange.max
+    && geometry.sample == mSample
+    && geometry.bounded == mBounded
+    && (!mBounded || geometry.bound == mBound)
+    && geometry.thickness == thickness
+    && geometry.color == lineColor
+    && geometry.borderTick == mBorderTick
+    && geometry.borderWidth == mBorderWidth
+    && geometry.borderColor == mBorderColor;
+  if (!isValid) {
+    return false;
+  }
+  render.loadVertices (geometry.vertices, position - geometry.position);
+  return true;
 }
 
 /////////////////////////////////////////////////
-sf::Vector2f Plotter::toPlot (const sf::Vector2f& point) const
+void Plotter::cacheGeometry (
+  const PlotCache& cache,
+  const sf::Vector2f& position,
+  const sf::Color& lineColor,
+  const float thickness,
+  const size_t firstVertex)
 {
-  return toPlot (point.x, point.y);
+  if (!mGeometries.has (cache.id)) {
+    mGeometries.emplace (cache.id);
+  }
+  auto& geometry = mGeometries.get (cache.id);
+  geometry.version = cache.version;
+  geometry.source = cache.source;
+  geometry.xRange = xRange;
+  geometry.yRange = yRange;
+  geometry.sample = mSample;
+  geometry.bounded = mBounded;
+  geometry.bound = mBound;
+  geometry.thickness = thickness;
+  geometry.color = lineColor;
+  geometry.borderTick = mBorderTick;
+  geometry.borderWidth = mBorderWidth;
+  geometry.borderColor = mBorderColor;
+  geometry.position = position;
+  render.copyVertices (firstVertex, geometry.vertices);
 }
 
 /////////////////////////////////////////////////
@@ -1,13 +1,18 @@
 #pragma once
 
 #include <functional>
+#include <type_traits>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
 
+#include "sgui/Core/ObjectPool.h"
 #include "sgui/Render/PrimitiveShapeRender.h"
 
 namespace sgui
 {
+class ThreadPool;
+class SeriesPyramid;
+
 /**
  * @brief plot range for an axis
  */
@@ -20,6 +25,54 @@ struct PlotRange {
 };
 
 
+/**
+ * @brief one curve of a multi-series plot. All series share the same x grid,
+ *   made of sample + 1 points spread regularly on the plot x range.
+ */
+struct PlotSeries {
+  std::function<float (float)> slope = {};    ///< y = f(x), used if values is null
+  const std::vector<float>* values = nullptr; ///< y on each point of the x grid
+  sf::Color color = sf::Color::White;         ///< Color of the line
+  float thickness = 1.f;                      ///< Thickness of the line
+};
+
+
+/**
+ * @brief identify a plot whose geometry is kept between frames. It's
+ *   regenerated only if version, ranges, bound, color or thickness change.
+ */
+struct PlotCache {
+  PlotCache () = default;
+  PlotCache (const uint32_t plotId, const uint64_t dataVersion, const void* dataSource = nullptr)
+    : id (plotId), version (dataVersion), source (dataSource) {}
+  uint32_t id = 0u;               ///< Identifier of the plot, unique in a frame
+  uint64_t version = 0u;          ///< Version of the plotted data
+  const void* source = nullptr;   ///< Owner of the version, versions of different owners never match
+};
+
+
+/**
+ * @brief evaluate a function once per point of a regular sampling of range,
+ *   the k-th point is sampled at lerp (range.min, range.max, (first + k) / sample).
+ *   Points are filled as (x, f(x)) for y = f(x) and f(t) for (x, y) = f(t).
+ * @param slope is the function sampled, it must be thread safe if workers are used
+ * @param range is the sampled range
+ * @param sample is the number of subdivisions of range
+ * @param first is the index of the first point, it can be outside the range
+ * @param points are filled with the sampled points, its size set the number of points
+ * @param workers are used to sample the function, if any
+ */
+template <typename Function>
+void samplePlot (
+  const Function& slope,
+  const PlotRange& range,
+  const uint32_t sample,
+  const int first,
+  std::vector<sf::Vector2f>& points,
+  ThreadPool* workers = nullptr);
+
+
+
 /**
  * @brief plot function in a given range and level of sampling.
  */
@@ -31,6 +84,11 @@ public:
    * @param sample is the number of points used to sample curve.
    */
   void setSample (const uint32_t sample);
+  /**
+   * @brief set workers used to sample functions, nullptr to sample them on
+   *   the calling thread. Plotted functions must be thread safe if set.
+   */
+  void setWorkers (ThreadPool* workers);
   /**
    * @brief unset bound size of the plot
    */
@@ -58,6 +116,11 @@ public:
    * @brief clear all plotted function
    */
   void clear ();
+  /**
+   * @brief set resource used by shapes and samples of a frame, they are
+   *   dropped without allocating. Cached geometries are kept on the heap.
+   */
+  void setMemoryResource (std::pmr::memory_resource* resource);
   /**
    * @brief plot a function y = f(x)
    * @param slope is a lambda of the form y = f(x)
@@ -66,6 +129,16 @@ public:
    * @param thickness set the thickness of the line
    */
   void plot (const std::function<float (float)>& slope, const sf::Vector2f& position, const sf::Color& lineColor, const float thickness = 1.f);
+  /**
+   * @brief plot a function y = f(x) without type erasure, so that it can be inlined
+   * @param slope is a callable of the form y = f(x)
+   * @param position is the position of the plot
+   * @param lineColor set the color of the line
+   * @param thickness set the thickness of the line
+   */
+  template <typename Function,
+    typename = std::enable_if_t<std::is_invocable_r_v<float, const Function&, float>>>
+  void plot (const Function& slope, const sf::Vector2f& position, const sf::Color& lineColor, const float thickness = 1.f);
   /**
    * @brief plot a parametric function (x, y) = f(t)
    * @param slope is a lambda of the form (x, y) = f(t)
@@ -82,14 +155,80 @@ public:
    * @param thickness set the thickness of the line/dot
    */
   void plot (const std::vector <sf::Vector2f>& points, const sf::Vector2f& position, const sf::Color& lineColor, const float thickness);
+  /**
+   * @brief plot a sampled series on xRange. Only the pyramid level matching
+   *   the plot width in pixels is read, so the cost depends on pixels, not on
+   *   samples. When the plot is not bounded, it has no width and the sample
+   *   set with setSample is used as the number of columns.
+   * @param series is the series to be drawn
+   * @param position is the position of the plot
+   * @param lineColor set the color of the line
+   * @param thickness set the thickness of the line
+   */
+  void plot (const SeriesPyramid& series, const sf::Vector2f& position, const sf::Color& lineColor, const float thickness);
+  /**
+   * @brief plot a set of point, or copy its geometry generated in a previous
+   *   frame if neither data nor settings changed since. Geometry is only
+   *   translated if the plot moved.
+   * @param cache identify the plot and the version of its data
+   */
+  void plot (const std::vector <sf::Vector2f>& points, const sf::Vector2f& position, const sf::Color& lineColor, const float thickness, const PlotCache& cache);
+  /**
+   * @brief plot a sampled series, or copy its cached geometry like above
+   */
+  void plot (const SeriesPyramid& series, const sf::Vector2f& position, const sf::Color& lineColor, const float thickness, const PlotCache& cache);
+  /**
+   * @brief plot several series on the same axes. The x grid is sampled and
+   *   remapped once, and axes are drawn once for all series.
+   * @param series are the series to be drawn
+   * @param position is the position of the plot
+   */
+  void plot (const std::vector<PlotSeries>& series, const sf::Vector2f& position);
+  /**
+   * @brief plot several series, or copy their cached geometry. Version must
+   *   change if any series data, color or thickness change.
+   */
+  void plot (const std::vector<PlotSeries>& series, const sf::Vector2f& position, const PlotCache& cache);
+  /**
+   * @brief copy geometry cached in a previous frame, if neither data nor
+   *   settings changed since. It lets data be gathered only when needed.
+   * @return false if the plot must be generated again
+   */
+  bool loadCachedGeometry (const PlotCache& cache, const sf::Vector2f& position, const sf::Color& lineColor, const float thickness);
+  /**
+   * @brief remove all cached geometries
+   */
+  void clearCache ();
 public:
   PlotRange xRange = {};       ///< Plot range along x
   PlotRange yRange = {};       ///< Plot range along y
   PrimitiveShapeRender render; ///< Render used
 private:
-  // to remap value in the draw area
-  sf::Vector2f toPlot (const float pointX, const float pointY) const;
-  sf::Vector2f toPlot (const sf::Vector2f& point) const;
+  // geometry of a plot and the settings used to generate it
+  struct PlotGeometry {
+    uint64_t version = 0u;
+    const void* source = nullptr;
+    PlotRange xRange = {};
+    PlotRange yRange = {};
+    uint32_t sample = 0u;
+    bool bounded = false;
+    sf::Vector2f bound = {};
+    float thickness = 0.f;
+    sf::Color color = {};
+    uint32_t borderTick = 0u;
+    float borderWidth = 0.f;
+    sf::Color borderColor = {};
+    sf::Vector2f position = {};
+    std::vector<sf::Vertex> vertices;
+  };
+  // remapping of each axis in the draw area
+  AxisRemap xAxisRemap (const sf::Vector2f& position) const;
+  AxisRemap yAxisRemap (const sf::Vector2f& position) const;
+  // store geometry generated since firstVertex
+  void cacheGeometry (const PlotCache& cache, const sf::Vector2f& position, const sf::Color& lineColor, const float thickness, const size_t firstVertex);
+  // sample a function, each sample being evaluated once, and plot it
+  template <typename Function>
+  void plotSampled (const Function& slope, const sf::Vector2f& position, const sf::Color& lineColor, const float thickness);
   // plot boundaries and axes for bounded plot
   void drawBorderAndAxes (const sf::Vector2f& position);
   // draw all function plotted
@@ -101,6 +240,15 @@ private:
   float mBorderWidth = 4.f;
   sf::Vector2f mBound = {};
   sf::Color mBorderColor = sf::Color::White;
+  ThreadPool* mWorkers = nullptr;
+  std::vector<sf::Vector2f> mPoints;
+  std::pmr::vector<float> mPlotX;
+  std::pmr::vector<float> mPlotY;
+  std::pmr::vector<float> mGridX;
+  std::pmr::vector<float> mSeriesY;
+  ObjectPool<PlotGeometry> mGeometries;
 };
 
 } // namespace sgui
+
+#include "sgui/Render/Plotter.tpp"
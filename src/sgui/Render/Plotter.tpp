@@ -0,0 +1,63 @@
+#include "sgui/Core/ThreadPool.h"
+#include "sgui/Core/Interpolation.h"
+
+namespace sgui
+{
+/////////////////////////////////////////////////
+template <typename Function>
+void samplePlot (
+  const Function& slope,
+  const PlotRange& range,
+  const uint32_t sample,
+  const int first,
+  std::vector<sf::Vector2f>& points,
+  ThreadPool* workers)
+{
+  const auto max = static_cast<float> (sample);
+  const auto sampleChunk = [&] (const size_t begin, const size_t end) {
+    for (auto k = begin; k < end; k++) {
+      const auto x = lerp (range.min, range.max, (first + static_cast<int> (k)) / max);
+      if constexpr (std::is_invocable_r_v<float, const Function&, float>) {
+        points [k] = sf::Vector2f (x, static_cast<float> (slope (x)));
+      } else {
+        points [k] = slope (x);
+      }
+    }
+  };
+
+  // below a few hundred points, waking workers cost more than sampling
+  constexpr auto grain = size_t (256);
+  if (workers && points.size () > grain) {
+    workers->parallelFor (points.size (), sampleChunk, grain);
+  } else {
+    sampleChunk (0, points.size ());
+  }
+}
+
+/////////////////////////////////////////////////
+template <typename Function, typename>
+void Plotter::plot (
+  const Function& slope,
+  const sf::Vector2f& position,
+  const sf::Color& lineColor,
+  const float thickness)
+{
+  plotSampled (slope, position, lineColor, thickness);
+}
+
+/////////////////////////////////////////////////
+template <typename Function>
+void Plotter::plotSampled (
+  const Function& slope,
+  const sf::Vector2f& position,
+  const sf::Color& lineColor,
+  const float thickness)
+{
+  // draw n=sample lines, points before and after the range are only used to
+  // join the first and last lines
+  mPoints.resize (mSample + 3);
+  samplePlot (slope, xRange, mSample, -1, mPoints, mWorkers);
+  plot (mPoints, position, lineColor, thickness);
+}
+
+} // namespace sgui
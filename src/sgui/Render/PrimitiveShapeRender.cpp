@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <spdlog/spdlog.h>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include "sgui/Render/PrimitiveShapeRender.h"
 
@@ -12,8 +14,7 @@ void PrimitiveShapeRender::updateView (const sf::View& newView)
 /////////////////////////////////////////////////
 void PrimitiveShapeRender::initializeClippingLayers ()
 {
-  mShapes.emplace_back (sf::VertexArray ());
-  mShapes.back ().setPrimitiveType (sf::PrimitiveType::Triangles);
+  nextLayerShapes ();
   const auto activeLayer = clipping.initialize ();
   mLayers.emplace_back (activeLayer);
 }
@@ -22,8 +23,7 @@ void PrimitiveShapeRender::initializeClippingLayers ()
 uint32_t PrimitiveShapeRender::setCurrentClippingLayer (const sf::FloatRect& mask)
 {
   // reserve memory for meshes and layers
-  mShapes.emplace_back (sf::VertexArray ());
-  mShapes.back ().setPrimitiveType (sf::PrimitiveType::Triangles);
+  nextLayerShapes ();
   // store active layer id and return it
   const auto activeLayer = clipping.setCurrentLayer (mask);
   mLayers.emplace_back (activeLayer);
@@ -33,11 +33,77 @@ uint32_t PrimitiveShapeRender::setCurrentClippingLayer (const sf::FloatRect& mas
 /////////////////////////////////////////////////
 void PrimitiveShapeRender::clear ()
 {
-  mShapes.clear ();
+  // clear shapes but keep their memory
+  for (uint32_t index = 0; index < mShapesCount; index++) {
+    mShapes [index].clear ();
+  }
+  mShapesCount = 0u;
   mLayers.clear ();
   initializeClippingLayers ();
 }
 
+/////////////////////////////////////////////////
+void PrimitiveShapeRender::setMemoryResource (std::pmr::memory_resource* resource)
+{
+  // meshes of every layer are rebuilt, empty, on the new resource
+  mResource = resource;
+  for (auto& shapes : mShapes) {
+    rebindResource (shapes, resource);
+  }
+  mShapesCount = 0u;
+  rebindResource (mLayers, resource);
+}
+
+/////////////////////////////////////////////////
+std::pmr::vector<sf::Vertex>& PrimitiveShapeRender::nextLayerShapes ()
+{
+  if (mShapesCount == mShapes.size ()) {
+    mShapes.emplace_back (mResource);
+  }
+  return mShapes [mShapesCount++];
+}
+
+/////////////////////////////////////////////////
+size_t PrimitiveShapeRender::vertexCount () const
+{
+  return mShapes.at (clipping.activeLayer ()).size ();
+}
+
+/////////////////////////////////////////////////
+void PrimitiveShapeRender::copyVertices (
+  const size_t first,
+  std::vector<sf::Vertex>& vertices) const
+{
+  const auto& activeMesh = mShapes.at (clipping.activeLayer ());
+  const auto count = activeMesh.size ();
+  vertices.clear ();
+  if (first >= count) {
+    return;
+  }
+  vertices.resize (count - first);
+  std::copy (&activeMesh [first], &activeMesh [first] + (count - first), vertices.begin ());
+}
+
+/////////////////////////////////////////////////
+void PrimitiveShapeRender::loadVertices (
+  const std::vector<sf::Vertex>& vertices,
+  const sf::Vector2f& shift)
+{
+  if (vertices.empty ()) {
+    return;
+  }
+  auto& activeMesh = mShapes.at (clipping.activeLayer ());
+  const auto first = activeMesh.size ();
+  activeMesh.resize (first + vertices.size ());
+  auto* vertex = &activeMesh [first];
+  std::copy (vertices.begin (), vertices.end (), vertex);
+  if (shift != sf::Vector2f ()) {
+    for (size_t i = 0; i < vertices.size (); i++) {
+      vertex [i].position += shift;
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 void PrimitiveShapeRender::load (
   const LineFloat& line,
@@ -62,6 +128,57 @@ void PrimitiveShapeRender::loadConnected (
   );
 }
 
+/////////////////////////////////////////////////
+void PrimitiveShapeRender::loadConnectedLines (
+  const float* x,
+  const float* y,
+  const size_t count,
+  const float thickness,
+  const sf::Color& color)
+{
+  // we need at least one line between the two guide points
+  if (count < 4) {
+    return;
+  }
+
+  // compute normals once per point instead of twice per line
+  auto& buffer = mPolyline;
+  buffer.resize (count);
+  Kernels::lineDirections (x, y, count, buffer.directionX.data (), buffer.directionY.data ());
+  Kernels::miterNormals (buffer.directionX.data (), buffer.directionY.data (), count, buffer.normalX.data (), buffer.normalY.data ());
+
+  // extrude drawn points, i.e. all except the guide points, on both sides
+  const auto thick = 0.5f * thickness;
+  const auto drawn = count - 2;
+  Kernels::extrude (x + 1, y + 1, buffer.normalX.data () + 1, buffer.normalY.data () + 1,
+    drawn, -thick, mPosition, buffer.leftX.data (), buffer.leftY.data ());
+  Kernels::extrude (x + 1, y + 1, buffer.normalX.data () + 1, buffer.normalY.data () + 1,
+    drawn, thick, mPosition, buffer.rightX.data (), buffer.rightY.data ());
+
+  // write the two triangles of each line directly in the mesh
+  auto& activeMesh = mShapes.at (clipping.activeLayer ());
+  const auto first = activeMesh.size ();
+  const auto lines = drawn - 1;
+  activeMesh.resize (first + 6 * lines);
+  auto* vertex = &activeMesh [first];
+  for (size_t i = 0; i < lines; i++, vertex += 6) {
+    const auto lower1 = sf::Vector2f (buffer.leftX [i], buffer.leftY [i]);
+    const auto lower2 = sf::Vector2f (buffer.leftX [i + 1], buffer.leftY [i + 1]);
+    const auto upper1 = sf::Vector2f (buffer.rightX [i], buffer.rightY [i]);
+    const auto upper2 = sf::Vector2f (buffer.rightX [i + 1], buffer.rightY [i + 1]);
+    // same winding as computeConnectedLineMesh
+    vertex [0].position = lower1;
+    vertex [1].position = lower2;
+    vertex [2].position = upper2;
+    vertex [3].position = upper2;
+    vertex [4].position = upper1;
+    vertex [5].position = lower1;
+    for (size_t v = 0; v < 6; v++) {
+      vertex [v].color = color;
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 void PrimitiveShapeRender::loadArrow (
   const LineFloat& arrow,
@@ -93,28 +210,8 @@ void PrimitiveShapeRender::load (
   const sf::Color& color,
   const uint32_t sample)
 {
-  // define angle variation and unit vector
-  const auto deltaTau = 2 * Pi / sample;
-  const auto i = sf::Vector2f (1.f, 0.f);
-  const auto j = sf::Vector2f (0.f, 1.f);
-
-  // sample point along the circle
-  const auto center = circle.center;
-  const auto& radius = circle.radius;
-  for (uint32_t angle = 1; angle < sample + 1; angle++) {
-    const auto prev = (angle - 1) * deltaTau;
-    const auto a1 = (angle % sample) * deltaTau;
-    const auto a2 = ((angle + 1) % sample) * deltaTau;
-    const auto next = ((angle + 2) % sample) * deltaTau;
-    computeConnectedLineMesh (
-      center + radius * sf::Vector2f (i*std::cos(a1)   + j*std::sin(a1)),
-      center + radius * sf::Vector2f (i*std::cos(a2)   + j*std::sin(a2)),
-      center + radius * sf::Vector2f (i*std::cos(prev) + j*std::sin(prev)),
-      center + radius * sf::Vector2f (i*std::cos(next) + j*std::sin(next)),
-      thickness,
-      color
-    );
-  }
+  const auto& mesh = mMeshes.get (ShapeKind::CircleEdge, sample);
+  instantiate (mesh, &circle.center, 1, &circle.radius, 1, &color, 1, thickness);
 }
 
 /////////////////////////////////////////////////
@@ -123,22 +220,31 @@ void PrimitiveShapeRender::loadFilled (
   const sf::Color& color,
   const uint32_t sample)
 {
-  // define angle variation and unit vector
-  const auto deltaTau = 2 * Pi / sample;
-  const auto i = sf::Vector2f (1.f, 0.f);
-  const auto j = sf::Vector2f (0.f, 1.f);
-
-  // the polygon is triangulated regularly using circle center
-  for (uint32_t angle = 0; angle < sample; angle++) {
-    auto a1 = angle * deltaTau;
-    auto a2 = ((angle + 1) % sample) * deltaTau;
-    computeTriangleVertices (
-      circle.center + circle.radius * sf::Vector2f (i*std::cos(a1) + j*std::sin(a1)),
-      circle.center + circle.radius * sf::Vector2f (i*std::cos(a2) + j*std::sin(a2)),
-      circle.center,
-      color
-    );
-  }
+  const auto& mesh = mMeshes.get (ShapeKind::Disc, sample);
+  instantiate (mesh, &circle.center, 1, &circle.radius, 1, &color, 1, 0.f);
+}
+
+/////////////////////////////////////////////////
+void PrimitiveShapeRender::loadMany (
+  const std::vector<sf::Vector2f>& centers,
+  const std::vector<float>& radii,
+  const std::vector<sf::Color>& colors,
+  const float thickness,
+  const uint32_t sample)
+{
+  const auto& mesh = mMeshes.get (ShapeKind::CircleEdge, sample);
+  instantiate (mesh, centers.data (), centers.size (), radii.data (), radii.size (), colors.data (), colors.size (), thickness);
+}
+
+/////////////////////////////////////////////////
+void PrimitiveShapeRender::loadFilledMany (
+  const std::vector<sf::Vector2f>& centers,
+  const std::vector<float>& radii,
+  const std::vector<sf::Color>& colors,
+  const uint32_t sample)
+{
+  const auto& mesh = mMeshes.get (ShapeKind::Disc, sample);
+  instantiate (mesh, centers.data (), centers.size (), radii.data (), radii.size (), colors.data (), colors.size (), 0.f);
 }
 
 /////////////////////////////////////////////////
@@ -256,9 +362,47 @@ void PrimitiveShapeRender::computeTriangleVertices (
 
   // add them to the render pipeline
   auto& activeMesh = mShapes.at (clipping.activeLayer ());
-  activeMesh.append (e1);
-  activeMesh.append (e2);
-  activeMesh.append (e3);
+  activeMesh.push_back (e1);
+  activeMesh.push_back (e2);
+  activeMesh.push_back (e3);
+}
+
+/////////////////////////////////////////////////
+void PrimitiveShapeRender::instantiate (
+  const ShapeMesh& mesh,
+  const sf::Vector2f* centers,
+  const size_t count,
+  const float* radii,
+  const size_t radiusCount,
+  const sf::Color* colors,
+  const size_t colorCount,
+  const float thickness)
+{
+  // radii and colors are either given per shape or shared
+  const auto isValid = [count] (const size_t size) { return size == 1 || size == count; };
+  if (count == 0 || mesh.base.empty () || !isValid (radiusCount) || !isValid (colorCount)) {
+    if (count > 0 && (!isValid (radiusCount) || !isValid (colorCount))) {
+      spdlog::warn ("PrimitiveShapeRender, {} shapes need 1 or {} radii and colors", count, count);
+    }
+    return;
+  }
+
+  // all instances are written in a pre-sized vertex array
+  auto& activeMesh = mShapes.at (clipping.activeLayer ());
+  const auto first = activeMesh.size ();
+  const auto meshSize = mesh.base.size ();
+  activeMesh.resize (first + count * meshSize);
+  auto* vertex = &activeMesh [first];
+  const auto thick = 0.5f * thickness;
+  for (size_t i = 0; i < count; i++) {
+    const auto center = centers [i] + mPosition;
+    const auto radius = radii [radiusCount == 1 ? 0 : i];
+    const auto color = colors [colorCount == 1 ? 0 : i];
+    for (size_t v = 0; v < meshSize; v++, vertex++) {
+      vertex->position = center + radius * mesh.base [v] + thick * mesh.offset [v];
+      vertex->color = color;
+    }
+  }
 }
 
 /////////////////////////////////////////////////
@@ -270,7 +414,8 @@ void PrimitiveShapeRender::draw (
   // draw each layer
   for (const auto layer : mLayers) {
     target.setView (clipping.at (layer));
-    target.draw (mShapes.at (layer), states);
+    const auto& shapes = mShapes.at (layer);
+    target.draw (shapes.data (), shapes.size (), sf::PrimitiveType::Triangles, states);
   }
 }
 
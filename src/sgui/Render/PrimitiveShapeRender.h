@@ -1,11 +1,16 @@
 #pragma once
 
+#include <vector>
+#include <memory_resource>
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/Graphics/Transformable.hpp>
 
+#include "sgui/Render/LineKernels.h"
+#include "sgui/Render/ShapeMeshes.h"
 #include "sgui/Render/ClippingLayers.h"
 #include "sgui/Core/Polygon.h"
+#include "sgui/Core/FrameArena.h"
 
 namespace sgui
 {
@@ -28,9 +33,30 @@ public:
    */
   uint32_t setCurrentClippingLayer (const sf::FloatRect& mask);
   /**
-   * @brief clear all shapes
+   * @brief clear all shapes, meshes are kept and reused by the next frame
    */
   void clear ();
+  /**
+   * @brief set resource used by meshes of a frame. They are dropped without
+   *   allocating, so the resource can be reset right after.
+   */
+  void setMemoryResource (std::pmr::memory_resource* resource);
+  /**
+   * @brief get number of vertices loaded in the active layer
+   */
+  size_t vertexCount () const;
+  /**
+   * @brief copy vertices of the active layer, from first to the last one
+   */
+  void copyVertices (
+         const size_t first,
+         std::vector<sf::Vertex>& vertices) const;
+  /**
+   * @brief load vertices in the active layer, translated by shift
+   */
+  void loadVertices (
+         const std::vector<sf::Vertex>& vertices,
+         const sf::Vector2f& shift = {});
   /**
    * @brief load thick line
    */
@@ -47,6 +73,18 @@ public:
          const sf::Vector2f& nextLine,
          const float thickness,
          const sf::Color& color = sf::Color::White);
+  /**
+   * @brief load a thick polyline given as separate x and y arrays. Like with
+   *   loadConnected, first and last points are not drawn and only orient the
+   *   junction of the first and last lines. The whole batch is tessellated
+   *   at once in a pre-sized vertex array.
+   */
+  void loadConnectedLines (
+         const float* x,
+         const float* y,
+         const size_t count,
+         const float thickness,
+         const sf::Color& color = sf::Color::White);
   /**
    * @brief load arrow shape
    */
@@ -56,7 +94,8 @@ public:
          const sf::Color color = sf::Color::White);
   /**
    * load circle edge or filled circle. Sample is the
-   * number of points used to sample the circle.
+   * number of points used to sample the circle. Circles are
+   * instanced from a unit mesh cached per sample count.
    */
   void load (
          const CircleFloat& circle,
@@ -67,6 +106,22 @@ public:
          const CircleFloat& circle,
          const sf::Color& color = sf::Color::White,
          const uint32_t sample = 50);
+  /**
+   * load many circles edge or filled circles in one batch. Radii
+   * and colors can hold one value per center or a single value
+   * shared by all circles.
+   */
+  void loadMany (
+         const std::vector<sf::Vector2f>& centers,
+         const std::vector<float>& radii,
+         const std::vector<sf::Color>& colors,
+         const float thickness,
+         const uint32_t sample = 50);
+  void loadFilledMany (
+         const std::vector<sf::Vector2f>& centers,
+         const std::vector<float>& radii,
+         const std::vector<sf::Color>& colors,
+         const uint32_t sample = 50);
   /**
    * load polygons edge or filled polygons
    */
@@ -115,6 +170,23 @@ private:
          const sf::Vector2f& p2,
          const sf::Vector2f& p3,
          const sf::Color& color);
+  /**
+   * instantiate a unit mesh at each center, radii and colors
+   * hold one value per center or a single one
+   */
+  void instantiate (
+         const ShapeMesh& mesh,
+         const sf::Vector2f* centers,
+         const size_t count,
+         const float* radii,
+         const size_t radiusCount,
+         const sf::Color* colors,
+         const size_t colorCount,
+         const float thickness);
+  /**
+   * get mesh of a new layer, meshes of previous frames are reused
+   */
+  std::pmr::vector<sf::Vertex>& nextLayerShapes ();
   /**
    * draw all shape loaded
    */
@@ -123,8 +195,13 @@ private:
          sf::RenderStates states) const override;
 private:
   sf::Vector2f mPosition = {};
-  std::vector <uint32_t> mLayers;
-  std::vector <sf::VertexArray> mShapes;
+  std::pmr::memory_resource* mResource = std::pmr::get_default_resource ();
+  std::pmr::vector <uint32_t> mLayers;
+  // shapes after mShapesCount are unused and kept for next frames
+  uint32_t mShapesCount = 0u;
+  std::vector <std::pmr::vector <sf::Vertex>> mShapes;
+  PolylineBuffer mPolyline;
+  ShapeMeshes mMeshes;
 };
 
 } // namespace sgui
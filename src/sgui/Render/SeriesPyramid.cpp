@@ -0,0 +1,233 @@
+#include <cmath>
+#include <atomic>
+#include <limits>
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+#include "sgui/Render/SeriesPyramid.h"
+
+namespace sgui
+{
+namespace
+{
+// versions are unique between all series
+std::atomic<uint64_t> NextVersion = 1u;
+} // namespace
+
+/////////////////////////////////////////////////
+bool SeriesPyramid::loadFromFile (
+  const std::string& filename,
+  const float xStart,
+  const float xStep)
+{
+  mOwned.clear ();
+  if (!mFile.open (filename)) {
+    spdlog::error ("SeriesPyramid::loadFromFile, unable to map {}", filename);
+    mSamples = nullptr;
+    mSize = 0;
+    mLevels.clear ();
+    return false;
+  }
+  mSamples = reinterpret_cast<const float*> (mFile.data ());
+  mSize = mFile.size () / sizeof (float);
+  mXStart = xStart;
+  mXStep = xStep;
+  buildLevels ();
+  return true;
+}
+
+/////////////////////////////////////////////////
+void SeriesPyramid::setData (
+  std::vector<float>&& samples,
+  const float xStart,
+  const float xStep)
+{
+  mFile.close ();
+  mOwned = std::move (samples);
+  mSamples = mOwned.data ();
+  mSize = mOwned.size ();
+  mXStart = xStart;
+  mXStep = xStep;
+  buildLevels ();
+}
+
+/////////////////////////////////////////////////
+size_t SeriesPyramid::size () const
+{
+  return mSize;
+}
+
+/////////////////////////////////////////////////
+uint64_t SeriesPyramid::version () const
+{
+  return mVersion;
+}
+
+/////////////////////////////////////////////////
+size_t SeriesPyramid::levelCount () const
+{
+  return mLevels.size ();
+}
+
+/////////////////////////////////////////////////
+PlotRange SeriesPyramid::xSpan () const
+{
+  if (mSize == 0) {
+    return PlotRange (mXStart, mXStart);
+  }
+  return PlotRange (mXStart, abscissa (static_cast<double> (mSize - 1)));
+}
+
+/////////////////////////////////////////////////
+PlotRange SeriesPyramid::ySpan () const
+{
+  if (mSize == 0) {
+    return PlotRange (0.f, 0.f);
+  }
+  // coarsest level summarize the whole series in a few values
+  if (!mLevels.empty ()) {
+    const auto& top = mLevels.back ();
+    const auto min = *std::min_element (top.min.begin (), top.min.end ());
+    const auto max = *std::max_element (top.max.begin (), top.max.end ());
+    return PlotRange (min, max);
+  }
+  const auto extremum = std::minmax_element (mSamples, mSamples + mSize);
+  return PlotRange (*extremum.first, *extremum.second);
+}
+
+/////////////////////////////////////////////////
+void SeriesPyramid::sample (
+  const PlotRange& xRange,
+  const uint32_t pixels,
+  std::vector<sf::Vector2f>& points) const
+{
+  points.clear ();
+  if (mSize == 0 || pixels == 0 || mXStep <= 0.f) {
+    return;
+  }
+
+  // get samples index in range, with one more sample on each side so that
+  // the line reach the plot borders
+  const auto begin = std::floor ((xRange.min - mXStart) / mXStep) - 1.0;
+  const auto end = std::ceil ((xRange.max - mXStart) / mXStep) + 1.0;
+  const auto lastIndex = static_cast<double> (mSize - 1);
+  const auto first = static_cast<size_t> (std::clamp (begin, 0.0, lastIndex));
+  const auto last = static_cast<size_t> (std::clamp (end, 0.0, lastIndex));
+  if (first >= last) {
+    return;
+  }
+
+  // zoomed in enough to draw every sample
+  const auto count = last - first + 1;
+  if (count <= 2 * static_cast<size_t> (pixels)) {
+    sampleRaw (first, last, points);
+    return;
+  }
+
+  // pick the coarsest level that still has at least one block per pixel,
+  // or the raw samples if even the finest level is too coarse
+  const auto samplesPerPixel = static_cast<double> (count) / pixels;
+  const Level* level = nullptr;
+  for (const auto& candidate : mLevels) {
+    if (static_cast<double> (candidate.block) > samplesPerPixel) {
+      break;
+    }
+    level = &candidate;
+  }
+
+  // emit min and max of each pixel column
+  points.reserve (2 * pixels + 2);
+  points.emplace_back (abscissa (static_cast<double> (first)), mSamples [first]);
+  for (uint32_t column = 0; column < pixels; column++) {
+    const auto columnBegin = first + static_cast<size_t> (column * samplesPerPixel);
+    const auto columnEnd = std::min (first + static_cast<size_t> ((column + 1) * samplesPerPixel), last + 1);
+    if (columnBegin >= columnEnd) {
+      continue;
+    }
+    auto min = std::numeric_limits<float>::max ();
+    auto max = std::numeric_limits<float>::lowest ();
+    if (level) {
+      const auto blockBegin = columnBegin / level->block;
+      const auto blockEnd = std::min ((columnEnd - 1) / level->block + 1, level->min.size ());
+      for (auto block = blockBegin; block < blockEnd; block++) {
+        min = std::min (min, level->min [block]);
+        max = std::max (max, level->max [block]);
+      }
+    } else {
+      for (auto index = columnBegin; index < columnEnd; index++) {
+        min = std::min (min, mSamples [index]);
+        max = std::max (max, mSamples [index]);
+      }
+    }
+    const auto x = abscissa (0.5 * static_cast<double> (columnBegin + columnEnd - 1));
+    points.emplace_back (x, min);
+    // two identical points would give a degenerated segment
+    if (max > min) {
+      points.emplace_back (x, max);
+    }
+  }
+  points.emplace_back (abscissa (lastIndex), mSamples [last]);
+}
+
+/////////////////////////////////////////////////
+void SeriesPyramid::buildLevels ()
+{
+  mVersion = NextVersion++;
+  mLevels.clear ();
+  if (mSize <= BaseBlock) {
+    return;
+  }
+
+  // finest level is computed from samples
+  auto level = Level ();
+  level.block = BaseBlock;
+  const auto blockCount = (mSize + BaseBlock - 1) / BaseBlock;
+  level.min.resize (blockCount);
+  level.max.resize (blockCount);
+  for (size_t block = 0; block < blockCount; block++) {
+    const auto begin = mSamples + block * BaseBlock;
+    const auto end = mSamples + std::min ((block + 1) * BaseBlock, mSize);
+    const auto extremum = std::minmax_element (begin, end);
+    level.min [block] = *extremum.first;
+    level.max [block] = *extremum.second;
+  }
+  mLevels.push_back (std::move (level));
+
+  // each next level merge two blocks of the previous one
+  while (mLevels.back ().min.size () > 1) {
+    const auto& previous = mLevels.back ();
+    auto next = Level ();
+    next.block = 2 * previous.block;
+    const auto count = (previous.min.size () + 1) / 2;
+    next.min.resize (count);
+    next.max.resize (count);
+    for (size_t block = 0; block < count; block++) {
+      const auto a = 2 * block;
+      const auto b = std::min (a + 1, previous.min.size () - 1);
+      next.min [block] = std::min (previous.min [a], previous.min [b]);
+      next.max [block] = std::max (previous.max [a], previous.max [b]);
+    }
+    mLevels.push_back (std::move (next));
+  }
+}
+
+/////////////////////////////////////////////////
+void SeriesPyramid::sampleRaw (
+  const size_t first,
+  const size_t last,
+  std::vector<sf::Vector2f>& points) const
+{
+  points.reserve (last - first + 1);
+  for (auto index = first; index <= last; index++) {
+    points.emplace_back (abscissa (static_cast<double> (index)), mSamples [index]);
+  }
+}
+
+/////////////////////////////////////////////////
+float SeriesPyramid::abscissa (const double index) const
+{
+  // double precision to keep 100M+ indices exact
+  return static_cast<float> (mXStart + index * mXStep);
+}
+
+} // namespace sgui
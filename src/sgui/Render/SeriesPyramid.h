@@ -0,0 +1,108 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <SFML/System/Vector2.hpp>
+
+#include "sgui/Core/MappedFile.h"
+#include "sgui/Render/Plotter.h"
+
+namespace sgui
+{
+/**
+ * @brief source of a regularly sampled series y = f(xStart + i * xStep) that
+ *   can hold far more samples than what is drawable. It builds a min/max
+ *   pyramid of the series, so that sampling it for a given range only touch
+ *   a number of values proportional to the number of pixels drawn. Samples
+ *   can be owned or read from a memory-mapped file of raw floats.
+ */
+class SeriesPyramid
+{
+public:
+  /**
+   * @brief number of samples summarized by one entry of the finest level
+   */
+  static constexpr size_t BaseBlock = 64;
+  /**
+   * SeriesPyramid is movable but not copyable, as it can own a file mapping
+   */
+  SeriesPyramid () = default;
+  SeriesPyramid (SeriesPyramid&&) = default;
+  SeriesPyramid& operator= (SeriesPyramid&&) = default;
+  SeriesPyramid (const SeriesPyramid&) = delete;
+  SeriesPyramid& operator= (const SeriesPyramid&) = delete;
+  /**
+   * @brief map a file of raw native-endian 32 bits floats and build pyramid.
+   * @param filename is the path of the file to map
+   * @param xStart is the abscissa of the first sample
+   * @param xStep is the abscissa distance between two samples
+   * @return false if the file could not be mapped
+   */
+  bool loadFromFile (
+         const std::string& filename,
+         const float xStart = 0.f,
+         const float xStep = 1.f);
+  /**
+   * @brief take ownership of samples and build pyramid.
+   */
+  void setData (
+         std::vector<float>&& samples,
+         const float xStart = 0.f,
+         const float xStep = 1.f);
+  /**
+   * @brief get number of samples in the series
+   */
+  size_t size () const;
+  /**
+   * @brief get version of the data, it change each time data are set
+   */
+  uint64_t version () const;
+  /**
+   * @brief get number of levels in the pyramid
+   */
+  size_t levelCount () const;
+  /**
+   * @brief get abscissa range covered by the series
+   */
+  PlotRange xSpan () const;
+  /**
+   * @brief get minimum and maximum value of the series
+   */
+  PlotRange ySpan () const;
+  /**
+   * @brief sample series on a range to draw it on a given number of pixels.
+   *   When more than one sample fall in a pixel, the minimum and maximum of
+   *   the pixel column are emitted, so that no peak is lost.
+   * @param xRange is the abscissa range to sample
+   * @param pixels is the number of pixel columns available
+   * @param points is filled with the points to draw, previous content is erased
+   */
+  void sample (
+         const PlotRange& xRange,
+         const uint32_t pixels,
+         std::vector<sf::Vector2f>& points) const;
+private:
+  // min and max of consecutive blocks of samples
+  struct Level {
+    size_t block = 0;
+    std::vector<float> min;
+    std::vector<float> max;
+  };
+  // build all levels from samples
+  void buildLevels ();
+  // emit raw samples between first and last
+  void sampleRaw (const size_t first, const size_t last, std::vector<sf::Vector2f>& points) const;
+  // abscissa of a sample
+  float abscissa (const double index) const;
+private:
+  const float* mSamples = nullptr;
+  size_t mSize = 0;
+  uint64_t mVersion = 0;
+  float mXStart = 0.f;
+  float mXStep = 1.f;
+  std::vector<float> mOwned;
+  MappedFile mFile;
+  std::vector<Level> mLevels;
+};
+
+} // namespace sgui
@@ -0,0 +1,104 @@
+#include <cmath>
+#include "sgui/Core/Shapes.h"
+#include "sgui/Render/ShapeMeshes.h"
+
+namespace sgui
+{
+namespace
+{
+/////////////////////////////////////////////////
+// points of the unit circle
+std::vector<sf::Vector2f> unitCircle (const uint32_t sample)
+{
+  const auto deltaTau = 2 * Pi / sample;
+  auto points = std::vector<sf::Vector2f> (sample);
+  for (uint32_t angle = 0; angle < sample; angle++) {
+    const auto a = angle * deltaTau;
+    points [angle] = sf::Vector2f (std::cos (a), std::sin (a));
+  }
+  return points;
+}
+} // namespace
+
+/////////////////////////////////////////////////
+const ShapeMesh& ShapeMeshes::get (
+  const ShapeKind kind,
+  const uint32_t sample)
+{
+  const auto key = (static_cast<uint64_t> (kind) << 32) | sample;
+  const auto mesh = mMeshes.find (key);
+  if (mesh != mMeshes.end ()) {
+    return mesh->second;
+  }
+  if (kind == ShapeKind::CircleEdge) {
+    return mMeshes.emplace (key, buildCircleEdge (sample)).first->second;
+  }
+  return mMeshes.emplace (key, buildDisc (sample)).first->second;
+}
+
+/////////////////////////////////////////////////
+void ShapeMeshes::clear ()
+{
+  mMeshes.clear ();
+}
+
+/////////////////////////////////////////////////
+ShapeMesh ShapeMeshes::buildCircleEdge (const uint32_t sample)
+{
+  auto mesh = ShapeMesh ();
+  if (sample < 3) {
+    return mesh;
+  }
+
+  // compute miter normal at each point, they don't depend on radius
+  const auto points = unitCircle (sample);
+  auto normals = std::vector<sf::Vector2f> (sample);
+  for (uint32_t k = 0; k < sample; k++) {
+    const auto& prev = points [(k + sample - 1) % sample];
+    const auto& next = points [(k + 1) % sample];
+    const auto dirPrev = (points [k] - prev).normalized ();
+    const auto dirNext = (next - points [k]).normalized ();
+    normals [k] = (dirPrev + dirNext).perpendicular ().normalized ();
+  }
+
+  // two triangles per edge, in the same order as a connected line mesh
+  mesh.base.reserve (6 * sample);
+  mesh.offset.reserve (6 * sample);
+  const auto addVertex = [&mesh, &points, &normals] (const uint32_t k, const float side) {
+    mesh.base.push_back (points [k]);
+    mesh.offset.push_back (side * normals [k]);
+  };
+  for (uint32_t angle = 1; angle < sample + 1; angle++) {
+    const auto k1 = angle % sample;
+    const auto k2 = (angle + 1) % sample;
+    addVertex (k1, -1.f);
+    addVertex (k2, -1.f);
+    addVertex (k2, 1.f);
+    addVertex (k2, 1.f);
+    addVertex (k1, 1.f);
+    addVertex (k1, -1.f);
+  }
+  return mesh;
+}
+
+/////////////////////////////////////////////////
+ShapeMesh ShapeMeshes::buildDisc (const uint32_t sample)
+{
+  auto mesh = ShapeMesh ();
+  if (sample < 3) {
+    return mesh;
+  }
+
+  // the polygon is triangulated regularly using circle center
+  const auto points = unitCircle (sample);
+  mesh.base.reserve (3 * sample);
+  for (uint32_t angle = 0; angle < sample; angle++) {
+    mesh.base.push_back (points [angle]);
+    mesh.base.push_back (points [(angle + 1) % sample]);
+    mesh.base.push_back (sf::Vector2f ());
+  }
+  mesh.offset.resize (mesh.base.size ());
+  return mesh;
+}
+
+} // namespace sgui
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <SFML/System/Vector2.hpp>
+
+namespace sgui
+{
+/**
+ * @brief kind of shapes that can be instanced from a unit mesh
+ */
+enum class ShapeKind : uint32_t {
+  CircleEdge,
+  Disc
+};
+
+/**
+ * @brief triangles of a shape of unit size centered on the origin. A vertex
+ *   of an instance is center + size * base + halfThickness * offset, so that
+ *   the same mesh serves any size and thickness.
+ */
+struct ShapeMesh {
+  std::vector<sf::Vector2f> base;
+  std::vector<sf::Vector2f> offset;
+};
+
+/**
+ * @brief cache of unit meshes, trigonometric functions are only evaluated
+ *   the first time a shape is requested with a given sample count.
+ */
+class ShapeMeshes
+{
+public:
+  /**
+   * @brief get unit mesh of a shape, it's built if needed
+   * @param kind of the shape
+   * @param sample is the number of points used to sample the shape
+   */
+  const ShapeMesh& get (
+         const ShapeKind kind,
+         const uint32_t sample);
+  /**
+   * @brief remove all meshes
+   */
+  void clear ();
+private:
+  // build unit meshes
+  static ShapeMesh buildCircleEdge (const uint32_t sample);
+  static ShapeMesh buildDisc (const uint32_t sample);
+private:
+  std::unordered_map<uint64_t, ShapeMesh> mMeshes;
+};
+
+} // namespace sgui
@@ -1,50 +1,104 @@
+#include <algorithm>
 #include "sgui/Render/TextureMeshes.h"
 #include "sgui/Render/MeshFunctions.h"
 #include "sgui/Resources/TextureAtlas.h"
+#include "sgui/Resources/MappedTextureAtlas.h"
 
 namespace sgui
 {
 /////////////////////////////////////////////////
 void TextureMeshes::computeTextureMapping (const TextureAtlas& map)
 {
+  // sort entries by name, so that they can be searched without hashing
+  auto sorted = std::vector <std::pair <std::string_view, const Frames*>> ();
+  sorted.reserve (std::distance (std::begin (map), std::end (map)));
+  for (const auto& entry : map) {
+    sorted.emplace_back (entry.first, &entry.second);
+  }
+  std::sort (std::begin (sorted), std::end (sorted));
+  mNames.clear ();
+  mIndexAndFrames.clear ();
+  mIndexAndFrames.reserve (sorted.size ());
+
   // cache every textures specified in the atlas
   uint32_t count = 0u;
   mTextureMeshes.clear ();
-  mTextureMeshes.resize (map.texturesCount ());
-  for (const auto& entry : map) {
+  mTextureMeshes.reserve (map.texturesCount ());
+  for (const auto& [texName, frames] : sorted) {
     // keep track of texture index
-    const auto texName = entry.first;
-    const auto framesCount = entry.second.count;
-    mIndexAndFrames [texName] = FrameAndIndex (framesCount, count);
+    const auto framesCount = frames->count;
+    const auto nameOffset = static_cast<uint32_t> (mNames.size ());
+    const auto nameSize = static_cast<uint32_t> (texName.size ());
+    mNames.append (texName);
+    mIndexAndFrames.emplace_back (nameOffset, nameSize, framesCount, count);
     // cache texture
     for (uint32_t frame = 0; frame < framesCount; frame++) {
-      const auto textureRect = map.textureRect (texName, frame);
-      if (textureRect.has_value ()) {
-        computeMeshTexture (mTextureMeshes [count], textureRect.value ());
-      } else {
-        computeMeshTexture (mTextureMeshes [count], sf::IntRect ({0, 0}, {16, 16}));
-      }
+      const auto shift = sf::Vector2i (frames->texture.size.x * frame, 0);
+      auto& mesh = mTextureMeshes.emplace_back ();
+      computeMeshTexture (mesh, sf::IntRect (frames->texture.position + shift, frames->texture.size));
+      count++;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void TextureMeshes::computeTextureMapping (const MappedTextureAtlas& map)
+{
+  // entries are already sorted, names are copied in one go
+  mNames.clear ();
+  mIndexAndFrames.clear ();
+  mIndexAndFrames.reserve (map.size ());
+  mTextureMeshes.clear ();
+  mTextureMeshes.reserve (map.texturesCount ());
+  uint32_t count = 0u;
+  for (uint32_t index = 0; index < map.size (); index++) {
+    // keep track of texture index
+    const auto texName = map.name (index);
+    const auto frames = map.frames (index);
+    const auto nameOffset = static_cast<uint32_t> (mNames.size ());
+    const auto nameSize = static_cast<uint32_t> (texName.size ());
+    mNames.append (texName);
+    mIndexAndFrames.emplace_back (nameOffset, nameSize, frames.count, count);
+    // cache texture
+    for (uint32_t frame = 0; frame < frames.count; frame++) {
+      const auto shift = sf::Vector2i (frames.texture.size.x * frame, 0);
+      auto& mesh = mTextureMeshes.emplace_back ();
+      computeMeshTexture (mesh, sf::IntRect (frames.texture.position + shift, frames.texture.size));
       count++;
     }
   }
 }
 
+/////////////////////////////////////////////////
+std::string_view TextureMeshes::name (const FrameAndIndex& entry) const
+{
+  return std::string_view (mNames).substr (entry.nameOffset, entry.nameSize);
+}
+
 /////////////////////////////////////////////////
 Mesh TextureMeshes::texture (
-  const std::string& texture,
+  std::string_view texture,
   const uint32_t frame) const
 {
+  // nothing to return if no atlas was set
+  if (mIndexAndFrames.empty () || mTextureMeshes.empty ()) {
+    return Mesh ();
+  }
   // check that texture exist !
-  const auto idx = mIndexAndFrames.find (texture);
-  if (idx == std::end (mIndexAndFrames)) {
-    return mTextureMeshes [std::begin (mIndexAndFrames)->second.textureIndex];
+  const auto idx = std::lower_bound (
+    std::begin (mIndexAndFrames), std::end (mIndexAndFrames), texture,
+    [this] (const FrameAndIndex& entry, std::string_view value) {
+      return name (entry) < value;
+    });
+  if (idx == std::end (mIndexAndFrames) || name (*idx) != texture) {
+    return mTextureMeshes [std::begin (mIndexAndFrames)->textureIndex];
   }
   // return first frame if frame is out of bond
-  if (frame >= idx->second.framesCount) {
-    return mTextureMeshes [idx->second.textureIndex];
+  if (frame >= idx->framesCount) {
+    return mTextureMeshes [idx->textureIndex];
   }
   // return asked frame if everything is ok
-  return mTextureMeshes [idx->second.textureIndex + frame];
+  return mTextureMeshes [idx->textureIndex + frame];
 }
 
 } // namespace sgui
@@ -1,14 +1,16 @@
 #pragma once
 
+#include <array>
 #include <vector>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <SFML/Graphics/Vertex.hpp>
 
 namespace sgui
 {
 // forward declaration and alias
 class TextureAtlas;
+class MappedTextureAtlas;
 using Mesh = std::array <sf::Vertex, 6>;
 
 /**
@@ -22,12 +24,18 @@ public:
    * @param texture Atlas of all the textures in the files
    */
   void computeTextureMapping (const TextureAtlas& textures);
+  /**
+   * @brief Compute texture mapping from a binary atlas, its names table is
+   *   copied as it is since entries are already sorted
+   * @param texture Atlas of all the textures in the files
+   */
+  void computeTextureMapping (const MappedTextureAtlas& textures);
   /**
    * @brief get computed texture mesh of an entry
    * @param textureID Identifier of the texture
    * @param frame Frame number of the texture, if it is animated
    */
-  Mesh texture (const std::string& textureID, const uint32_t frame = 0) const;
+  Mesh texture (std::string_view textureID, const uint32_t frame = 0) const;
   /**
    * To iterate through stored meshes
    */
@@ -36,17 +44,21 @@ public:
   auto begin () const { return std::cbegin (mTextureMeshes); }
   auto end ()   const { return std::cend (mTextureMeshes); }
 private:
-  // For a clearer internal interface
+  // For a clearer internal interface, name is a slice of mNames
   struct FrameAndIndex {
     FrameAndIndex () = default;
-    FrameAndIndex (uint32_t count, uint32_t index) 
-      : framesCount (count), textureIndex (index) {}
+    FrameAndIndex (uint32_t offset, uint32_t size, uint32_t count, uint32_t index)
+      : nameOffset (offset), nameSize (size), framesCount (count), textureIndex (index) {}
+    uint32_t nameOffset = 0u;
+    uint32_t nameSize = 0u;
     uint32_t framesCount = 0u;
     uint32_t textureIndex = 0u;
   };
+  std::string_view name (const FrameAndIndex& entry) const;
 private:
+  std::string mNames;
   std::vector <Mesh> mTextureMeshes;
-  std::unordered_map <std::string, FrameAndIndex> mIndexAndFrames;
+  std::vector <FrameAndIndex> mIndexAndFrames; // sorted by name
 };
 
 } // namespace sgui
@@ -0,0 +1,221 @@
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <spdlog/spdlog.h>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include "sgui/Resources/AssetBundle.h"
+#include "sgui/Resources/MappedTextureAtlas.h"
+
+namespace sgui
+{
+/////////////////////////////////////////////////
+AssetBundle::AssetBundle (const std::string& filename)
+{
+  if (!loadFromFile (filename)) {
+    spdlog::error ("AssetBundle: unable to load {}", filename);
+  }
+}
+
+/////////////////////////////////////////////////
+bool AssetBundle::loadFromFile (const std::string& filename)
+{
+  const auto func = std::string ("AssetBundle::loadFromFile :");
+  mEntries = nullptr;
+  mNames = nullptr;
+  mHeader = Header ();
+  if (!mFile.open (filename)) {
+    return false;
+  }
+  // check header, then that entries and names are in the file
+  auto header = Header ();
+  if (mFile.size () < sizeof (Header)) {
+    spdlog::error ("{} {} is too small to be a bundle", func, filename);
+    mFile.close ();
+    return false;
+  }
+  std::memcpy (&header, mFile.data (), sizeof (Header));
+  if (std::memcmp (header.magic, Header ().magic, sizeof (header.magic)) != 0
+      || header.version != Version) {
+    spdlog::error ("{} {} is not a bundle of version {}", func, filename, Version);
+    mFile.close ();
+    return false;
+  }
+  const auto tablesSize = sizeof (Header)
+    + static_cast<uint64_t> (header.entriesCount) * sizeof (Entry) + header.namesSize;
+  if (mFile.size () < tablesSize) {
+    spdlog::error ("{} {} is truncated", func, filename);
+    mFile.close ();
+    return false;
+  }
+  const auto entries = reinterpret_cast<const Entry*> (mFile.data () + sizeof (Header));
+  for (uint32_t index = 0; index < header.entriesCount; index++) {
+    const auto& entry = entries [index];
+    if (entry.offset > mFile.size () || entry.size > mFile.size () - entry.offset
+        || entry.nameOffset > header.namesSize || entry.nameSize > header.namesSize - entry.nameOffset) {
+      spdlog::error ("{} {} is corrupted", func, filename);
+      mFile.close ();
+      return false;
+    }
+  }
+  // entries are used in place, the mapping is page aligned
+  mHeader = header;
+  mEntries = entries;
+  mNames = reinterpret_cast<const char*> (mEntries + header.entriesCount);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool AssetBundle::isOpen () const
+{
+  return mEntries != nullptr;
+}
+
+/////////////////////////////////////////////////
+uint32_t AssetBundle::size () const
+{
+  return mHeader.entriesCount;
+}
+
+/////////////////////////////////////////////////
+std::string_view AssetBundle::name (const uint32_t index) const
+{
+  if (index >= mHeader.entriesCount) {
+    return {};
+  }
+  const auto& entry = mEntries [index];
+  return std::string_view (mNames + entry.nameOffset, entry.nameSize);
+}
+
+/////////////////////////////////////////////////
+bool AssetBundle::has (std::string_view name) const
+{
+  return static_cast<bool> (asset (name));
+}
+
+/////////////////////////////////////////////////
+AssetBundle::Asset AssetBundle::asset (std::string_view entry) const
+{
+  // binary search in the sorted names
+  auto first = 0u;
+  auto last = mHeader.entriesCount;
+  while (first < last) {
+    const auto middle = first + (last - first) / 2;
+    const auto comparison = name (middle).compare (entry);
+    if (comparison == 0) {
+      const auto& found = mEntries [middle];
+      return Asset { mFile.data () + found.offset, static_cast<size_t> (found.size) };
+    }
+    if (comparison < 0) {
+      first = middle + 1;
+    } else {
+      last = middle;
+    }
+  }
+  return Asset ();
+}
+
+/////////////////////////////////////////////////
+bool AssetBundle::openFont (
+  sf::Font& font,
+  std::string_view name) const
+{
+  const auto bytes = asset (name);
+  if (!bytes) {
+    spdlog::error ("AssetBundle::openFont : {} is not in the bundle", name);
+    return false;
+  }
+  return font.openFromMemory (bytes.data, bytes.size);
+}
+
+/////////////////////////////////////////////////
+bool AssetBundle::loadTexture (
+  sf::Texture& texture,
+  std::string_view name) const
+{
+  const auto bytes = asset (name);
+  if (!bytes) {
+    spdlog::error ("AssetBundle::loadTexture : {} is not in the bundle", name);
+    return false;
+  }
+  return texture.loadFromMemory (bytes.data, bytes.size);
+}
+
+/////////////////////////////////////////////////
+bool AssetBundle::loadAtlas (
+  MappedTextureAtlas& atlas,
+  std::string_view name) const
+{
+  const auto bytes = asset (name);
+  if (!bytes) {
+    spdlog::error ("AssetBundle::loadAtlas : {} is not in the bundle", name);
+    return false;
+  }
+  return atlas.loadFromMemory (bytes.data, bytes.size);
+}
+
+/////////////////////////////////////////////////
+// bundle creation
+/////////////////////////////////////////////////
+bool saveInBundle (
+  const std::vector <std::pair <std::string, std::string>>& assets,
+  const std::string& bundle)
+{
+  using Header = AssetBundle::Header;
+  using Entry = AssetBundle::Entry;
+  // read all files, sorted by name
+  auto success = true;
+  auto files = std::vector <std::pair <std::string, std::string>> ();
+  for (const auto& [name, filename] : assets) {
+    auto input = std::ifstream (filename, std::ios::binary);
+    if (!input) {
+      spdlog::error ("saveInBundle: unable to read {}", filename);
+      success = false;
+      continue;
+    }
+    auto data = std::string (std::istreambuf_iterator <char> (input), {});
+    files.emplace_back (name, std::move (data));
+  }
+  std::sort (std::begin (files), std::end (files));
+
+  // build entries and names table, data starts after them
+  auto header = Header ();
+  auto names = std::string ();
+  auto entries = std::vector <Entry> (files.size ());
+  for (uint32_t index = 0; index < files.size (); index++) {
+    entries [index].nameOffset = static_cast<uint32_t> (names.size ());
+    entries [index].nameSize = static_cast<uint32_t> (files [index].first.size ());
+    names.append (files [index].first);
+  }
+  header.entriesCount = static_cast<uint32_t> (entries.size ());
+  header.namesSize = static_cast<uint32_t> (names.size ());
+  const auto align = [] (const uint64_t offset) {
+    return (offset + AssetBundle::Alignment - 1) / AssetBundle::Alignment * AssetBundle::Alignment;
+  };
+  auto offset = align (sizeof (Header) + entries.size () * sizeof (Entry) + names.size ());
+  for (uint32_t index = 0; index < files.size (); index++) {
+    entries [index].offset = offset;
+    entries [index].size = files [index].second.size ();
+    offset = align (offset + entries [index].size);
+  }
+
+  // write everything, with padding between data
+  auto out = std::ofstream (bundle, std::ios::binary);
+  out.write (reinterpret_cast<const char*> (&header), sizeof (Header));
+  out.write (reinterpret_cast<const char*> (entries.data ()), entries.size () * sizeof (Entry));
+  out.write (names.data (), names.size ());
+  auto written = static_cast<uint64_t> (out.tellp ());
+  const auto padding = std::string (AssetBundle::Alignment, '\0');
+  for (uint32_t index = 0; index < files.size (); index++) {
+    out.write (padding.data (), entries [index].offset - written);
+    out.write (files [index].second.data (), files [index].second.size ());
+    written = entries [index].offset + entries [index].size;
+  }
+  if (!out) {
+    spdlog::error ("saveInBundle: unable to write {}", bundle);
+    return false;
+  }
+  return success;
+}
+
+} // namespace sgui
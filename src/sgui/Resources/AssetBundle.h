@@ -0,0 +1,134 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <string_view>
+
+#include "sgui/Core/MappedFile.h"
+
+// forward declaration
+namespace sf {
+  class Font;
+  class Texture;
+}
+
+namespace sgui
+{
+class MappedTextureAtlas;
+
+/**
+ * @brief Read-only archive of assets, packed in one file with saveInBundle.
+ * The bundle is memory-mapped once and assets are used in place: fonts are
+ * opened and textures decoded from memory, and binary atlases are read
+ * without any copy. The bundle must outlive fonts and atlases opened from it.
+ *
+ * File layout, in native byte order:
+ *    - Header
+ *    - Entry [entriesCount], sorted by name
+ *    - names, concatenated without separator
+ *    - assets data, each one aligned on 16 bytes
+ */
+class AssetBundle
+{
+public:
+  /**
+   * @brief bundle header
+   */
+  struct Header {
+    char magic [4] = { 'S', 'G', 'A', 'B' };
+    uint32_t version = 1u;
+    uint32_t entriesCount = 0u; ///< Number of assets
+    uint32_t namesSize = 0u;    ///< Size in bytes of the names table
+  };
+  /**
+   * @brief bundle entry, offset is counted from the beginning of the file
+   */
+  struct Entry {
+    uint32_t nameOffset = 0u;
+    uint32_t nameSize = 0u;
+    uint64_t offset = 0u;
+    uint64_t size = 0u;
+  };
+  /**
+   * @brief bytes of an asset, null if the asset doesn't exist
+   */
+  struct Asset {
+    const std::byte* data = nullptr;
+    size_t size = 0u;
+    explicit operator bool () const { return data != nullptr; }
+  };
+  static constexpr uint32_t Version = 1u;
+  static constexpr uint64_t Alignment = 16u;
+public:
+  /**
+   * @brief Build an empty bundle
+   */
+  AssetBundle () = default;
+  /**
+   * @brief Map a bundle
+   * @param filename File from which bundle is mapped
+   */
+  AssetBundle (const std::string& filename);
+  /**
+   * @brief Map a bundle, the previous one is unmapped
+   * @param filename File from which bundle is mapped
+   * @return `true` if the file is a valid bundle
+   */
+  bool loadFromFile (const std::string& filename);
+  /**
+   * @brief Test if a bundle is mapped
+   */
+  bool isOpen () const;
+  /**
+   * @brief Get number of assets in the bundle
+   */
+  uint32_t size () const;
+  /**
+   * @brief Get name of the asset at index, assets are sorted by name
+   */
+  std::string_view name (const uint32_t index) const;
+  /**
+   * @brief Test if bundle contains an asset
+   */
+  bool has (std::string_view name) const;
+  /**
+   * @brief Get bytes of an asset
+   * @param name Asset name, i.e. its file name when it was bundled
+   */
+  Asset asset (std::string_view name) const;
+  /**
+   * @brief Open a font stored in the bundle, without copying it
+   * @return `true` if the font was opened
+   */
+  bool openFont (sf::Font& font, std::string_view name) const;
+  /**
+   * @brief Load a texture from an image stored in the bundle
+   * @return `true` if the texture was loaded
+   */
+  bool loadTexture (sf::Texture& texture, std::string_view name) const;
+  /**
+   * @brief Use a binary texture atlas stored in the bundle, without copying it
+   * @return `true` if the atlas is valid
+   */
+  bool loadAtlas (MappedTextureAtlas& atlas, std::string_view name) const;
+private:
+  const Entry* mEntries = nullptr;
+  const char* mNames = nullptr;
+  Header mHeader = {};
+  MappedFile mFile;
+};
+
+/**
+ * @brief pack files in a bundle
+ * @param assets Pairs of asset name and file to pack, names must be unique
+ * @param bundle File in which the bundle is written
+ * @return `true` if all files were packed and the bundle written
+ */
+bool saveInBundle (
+  const std::vector <std::pair <std::string, std::string>>& assets,
+  const std::string& bundle);
+
+} // namespace sgui
@@ -0,0 +1,95 @@
+#include <mutex>
+#include <filesystem>
+#include <spdlog/spdlog.h>
+#include "sgui/Resources/DefaultResources.h"
+#include "sgui/DefaultFiles.h"
+
+namespace sgui
+{
+/////////////////////////////////////////////////
+std::shared_ptr <const AssetBundle> defaultBundle ()
+{
+  static auto mutex = std::mutex ();
+  static auto shared = std::weak_ptr <const AssetBundle> ();
+  const auto lock = std::lock_guard (mutex);
+  auto bundle = shared.lock ();
+  if (!bundle && std::filesystem::exists (DefaultBundle)) {
+    auto mapped = std::make_shared <AssetBundle> ();
+    if (mapped->loadFromFile (DefaultBundle)) {
+      bundle = std::move (mapped);
+      shared = bundle;
+    } else {
+      spdlog::warn ("defaultBundle: {} is not a valid bundle", DefaultBundle);
+    }
+  }
+  return bundle;
+}
+
+
+/////////////////////////////////////////////////
+DefaultResources::DefaultResources ()
+{
+  if (!load ()) {
+    spdlog::error ("DefaultResources: unable to load default resources");
+  }
+}
+
+/////////////////////////////////////////////////
+bool DefaultResources::load ()
+{
+  mBundle = defaultBundle ();
+  if (mBundle
+  && mBundle->openFont (mFont, DefaultFontAsset)
+  && mBundle->openFont (mBoldFont, DefaultBoldFontAsset)
+  && mBundle->loadTexture (mTexture, DefaultTextureAsset)
+  && mBundle->loadAtlas (mMappedAtlas, DefaultAtlasAsset)) {
+    return true;
+  }
+  if (mBundle) {
+    spdlog::warn ("DefaultResources::load : bundle is incomplete, contents files are used");
+    mBundle.reset ();
+  }
+  // bundle was not built, resources are read from each file
+  return mFont.openFromFile (DefaultFont)
+    && mBoldFont.openFromFile (DefaultBoldFont)
+    && mTexture.loadFromFile (DefaultTexture)
+    && mAtlas.loadFromFile (DefaultAtlas);
+}
+
+/////////////////////////////////////////////////
+bool DefaultResources::isBundled () const
+{
+  return mBundle != nullptr;
+}
+
+/////////////////////////////////////////////////
+sf::Font& DefaultResources::font ()
+{
+  return mFont;
+}
+
+/////////////////////////////////////////////////
+sf::Font& DefaultResources::boldFont ()
+{
+  return mBoldFont;
+}
+
+/////////////////////////////////////////////////
+sf::Texture& DefaultResources::texture ()
+{
+  return mTexture;
+}
+
+/////////////////////////////////////////////////
+const TextureAtlas& DefaultResources::atlas () const
+{
+  return mAtlas;
+}
+
+/////////////////////////////////////////////////
+const MappedTextureAtlas& DefaultResources::mappedAtlas () const
+{
+  return mMappedAtlas;
+}
+
+} // namespace sgui
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <memory>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+#include "sgui/Resources/AssetBundle.h"
+#include "sgui/Resources/TextureAtlas.h"
+#include "sgui/Resources/MappedTextureAtlas.h"
+
+namespace sgui
+{
+/**
+ * @brief Get the default bundle, it is mapped once and shared by all its users
+ * @return Shared bundle, null if it was not built or is not valid
+ */
+std::shared_ptr <const AssetBundle> defaultBundle ();
+
+/**
+ * @brief Default fonts, widgets texture and atlas of the library. They are
+ * opened from the default bundle, with the single mapping also used for the
+ * font awesome face of the gui, or from contents/ files if the bundle was not
+ * built. They must outlive the gui that use them.
+ */
+class DefaultResources
+{
+public:
+  /**
+   * @brief Load default resources
+   */
+  DefaultResources ();
+  /**
+   * @brief Load default resources, from the bundle if possible
+   * @return `true` if all resources were loaded
+   */
+  bool load ();
+  /**
+   * @brief Test if resources were opened from the default bundle, the atlas
+   *   is then a MappedTextureAtlas
+   */
+  bool isBundled () const;
+  /**
+   * @brief Get normal and bold fonts
+   */
+  sf::Font& font ();
+  sf::Font& boldFont ();
+  /**
+   * @brief Get widgets texture
+   */
+  sf::Texture& texture ();
+  /**
+   * @brief Get widgets atlas, when resources are not bundled
+   */
+  const TextureAtlas& atlas () const;
+  /**
+   * @brief Get widgets atlas, when resources are bundled
+   */
+  const MappedTextureAtlas& mappedAtlas () const;
+private:
+  std::shared_ptr <const AssetBundle> mBundle;
+  sf::Font mFont;
+  sf::Font mBoldFont;
+  sf::Texture mTexture;
+  TextureAtlas mAtlas;
+  MappedTextureAtlas mMappedAtlas;
+};
+
+} // namespace sgui
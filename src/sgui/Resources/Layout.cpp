@@ -1,3 +1,4 @@
+#include <algorithm>
 #include "sgui/Resources/Layout.h"
 #include "sgui/Serialization/LoadLayout.h"
 
@@ -36,13 +37,40 @@ void Layout::add (
   const std::string& entry,
   LayoutEntry&& data)
 {
-  if (m_layoutEntries.find (set) != std::end (m_layoutEntries)) {
-    m_layoutEntries.at (set).push_back (entry);
-  } else {
+  // register entry in its set, only once
+  if (m_layoutEntries.find (set) == std::end (m_layoutEntries)) {
     m_setFilenames.push_back (set);
     m_layoutEntries.insert ({set, std::vector <std::string> ()});
   }
-  m_entries.insert ({entry, std::move (data)});
+  auto& setEntries = m_layoutEntries.at (set);
+  if (std::find (std::begin (setEntries), std::end (setEntries), entry) == std::end (setEntries)) {
+    setEntries.push_back (entry);
+  }
+  // overwrite data in place, handles keep pointing to the entry
+  const auto stored = m_entries.find (entry);
+  if (stored != std::end (m_entries)) {
+    stored->second = std::move (data);
+  } else {
+    m_entries.insert ({entry, std::move (data)});
+  }
+}
+
+/////////////////////////////////////////////////
+void Layout::merge (Layout&& other)
+{
+  for (const auto& set : other.m_setFilenames) {
+    // register set even if it's empty, so that it is saved
+    if (m_layoutEntries.find (set) == std::end (m_layoutEntries)) {
+      m_setFilenames.push_back (set);
+      m_layoutEntries.insert ({set, std::vector <std::string> ()});
+    }
+    for (const auto& entry : other.m_layoutEntries.at (set)) {
+      const auto data = other.m_entries.find (entry);
+      if (data != std::end (other.m_entries)) {
+        add (set, entry, std::move (data->second));
+      }
+    }
+  }
 }
 
 } // namespace sgui
@@ -4,6 +4,7 @@
 #include <vector>
 #include <utility>
 #include <unordered_map>
+#include <spdlog/spdlog.h>
 
 #include "sgui/Widgets/Style.h"
 #include "sgui/Widgets/Panel.h"
@@ -25,6 +26,33 @@ struct LayoutEntry
 };
 
 
+/////////////////////////////////////////////////
+/**
+ * @brief typed handle on a layout entry, resolved once with Layout::handle.
+ *   It gives a direct access to the stored data without any string work and
+ *   it stays valid while the layout lives, even if more sets are loaded.
+ */
+template <typename LayoutType>
+class LayoutHandle
+{
+public:
+  LayoutHandle () = default;
+  explicit LayoutHandle (LayoutEntry* entry) : m_entry (entry) {}
+  /**
+   * @brief test if handle points to an entry
+   */
+  bool isValid () const { return m_entry != nullptr; }
+  /**
+   * @brief get entry data, handle must be valid
+   */
+  LayoutType& get () const;
+  LayoutType& operator* () const { return get (); }
+  LayoutType* operator-> () const { return &get (); }
+private:
+  LayoutEntry* m_entry = nullptr;
+};
+
+
 /////////////////////////////////////////////////
 /**
  * @brief allow to store and load Gui layou
@@ -45,12 +73,18 @@ public:
    */
   std::vector<std::string> entries (const std::string& set) const;
   /**
-   * @brief add or remove an entry to the layout
+   * @brief add an entry to the layout, an existing entry is overwritten in
+   *   place so that its handles see the new data
    */
   void add (
          const std::string& set,
          const std::string& entry,
          LayoutEntry&& data);
+  /**
+   * @brief add sets and entries of another layout, e.g. one loaded in the
+   *   background. Existing entries are overwritten in place.
+   */
+  void merge (Layout&& other);
   /**
    * @brief test if entry exist
    */
@@ -70,6 +104,15 @@ public:
   const LayoutType& get (
          const std::string& entry,
          bool addLayoutType = true) const;
+  /**
+   * @brief get a stable handle on an entry, to access it without hashing.
+   *   If the entry doesn't exist yet, a default one is created and will be
+   *   filled when a set containing it is loaded.
+   */
+  template <typename LayoutType>
+  LayoutHandle <LayoutType> handle (
+         const std::string& entry,
+         bool addLayoutType = true);
 private:
   std::vector <std::string> m_setFilenames;
   std::unordered_map <std::string, LayoutEntry> m_entries;
@@ -77,6 +120,17 @@ private:
 };
 
 
+/////////////////////////////////////////////////
+/**
+ * @brief get data of a given type in a layout entry
+ */
+template <typename LayoutType>
+LayoutType& layoutData (LayoutEntry& entry);
+
+template <typename LayoutType>
+const LayoutType& layoutData (const LayoutEntry& entry);
+
+
 /////////////////////////////////////////////////
 /**
  * @brief return special prefix to avoid name collision and to infer type from file
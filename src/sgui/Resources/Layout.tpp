@@ -37,14 +37,54 @@ const LayoutType& Layout::get (
   }
 
   // return requested entry
+  return layoutData <LayoutType> (m_entries.at (key));
+}
+
+/////////////////////////////////////////////////
+template <typename LayoutType>
+LayoutHandle <LayoutType> Layout::handle (
+  const std::string& entry,
+  bool addLayoutType)
+{
+  auto key = entry;
+  if (addLayoutType) {
+    key = layoutTypeName <LayoutType> () + entry;
+  }
+  // entries are never removed nor moved, so their address is stable
+  auto stored = m_entries.find (key);
+  if (stored == std::end (m_entries)) {
+    spdlog::warn ("Layout::handle : {} doesn't exist yet, a default entry is created", key);
+    stored = m_entries.insert ({key, LayoutEntry ()}).first;
+  }
+  return LayoutHandle <LayoutType> (&stored->second);
+}
+
+/////////////////////////////////////////////////
+template <typename LayoutType>
+LayoutType& LayoutHandle <LayoutType>::get () const
+{
+  return layoutData <LayoutType> (*m_entry);
+}
+
+/////////////////////////////////////////////////
+template <typename LayoutType>
+LayoutType& layoutData (LayoutEntry& entry)
+{
+  return const_cast <LayoutType&> (layoutData <LayoutType> (std::as_const (entry)));
+}
+
+/////////////////////////////////////////////////
+template <typename LayoutType>
+const LayoutType& layoutData (const LayoutEntry& entry)
+{
   if constexpr (std::is_same_v <LayoutType, Panel>) {
-    return m_entries.at (key).panel;
+    return entry.panel;
   } else if constexpr (std::is_same_v <LayoutType, sf::Vector2f>) {
-    return m_entries.at (key).position;
+    return entry.position;
   } else if constexpr (std::is_same_v <LayoutType, Window>) {
-    return m_entries.at (key).window;
+    return entry.window;
   } else {
-    return m_entries.at (key).constraints;
+    return entry.constraints;
   }
 }
 
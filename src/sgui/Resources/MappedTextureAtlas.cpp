@@ -0,0 +1,149 @@
+#include <cstring>
+#include <algorithm>
+#include <spdlog/spdlog.h>
+#include "sgui/Resources/MappedTextureAtlas.h"
+
+namespace sgui
+{
+/////////////////////////////////////////////////
+MappedTextureAtlas::MappedTextureAtlas (const std::string& filename)
+{
+  if (!loadFromFile (filename)) {
+    spdlog::error ("MappedTextureAtlas: unable to load {}", filename);
+  }
+}
+
+/////////////////////////////////////////////////
+bool MappedTextureAtlas::loadFromFile (const std::string& filename)
+{
+  if (!mFile.open (filename)) {
+    mEntries = nullptr;
+    mNames = nullptr;
+    mHeader = Header ();
+    return false;
+  }
+  if (!loadFromMemory (mFile.data (), mFile.size ())) {
+    spdlog::error ("MappedTextureAtlas::loadFromFile : {} is not a valid binary atlas", filename);
+    mFile.close ();
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool MappedTextureAtlas::loadFromMemory (
+  const std::byte* data,
+  const size_t size)
+{
+  const auto func = std::string ("MappedTextureAtlas::loadFromMemory :");
+  mEntries = nullptr;
+  mNames = nullptr;
+  mHeader = Header ();
+  // check header, data must contain exactly the header, entries and names
+  auto header = Header ();
+  if (!data || size < sizeof (Header)) {
+    spdlog::error ("{} data is too small to be a binary atlas", func);
+    return false;
+  }
+  std::memcpy (&header, data, sizeof (Header));
+  if (std::memcmp (header.magic, Header ().magic, sizeof (header.magic)) != 0
+      || header.version != Version) {
+    spdlog::error ("{} data is not a binary atlas of version {}", func, Version);
+    return false;
+  }
+  const auto entriesSize = static_cast<uint64_t> (header.entriesCount) * sizeof (Entry);
+  if (size != sizeof (Header) + entriesSize + header.namesSize) {
+    spdlog::error ("{} data is truncated or corrupted", func);
+    return false;
+  }
+  // entries are used in place
+  mHeader = header;
+  mEntries = reinterpret_cast<const Entry*> (data + sizeof (Header));
+  mNames = reinterpret_cast<const char*> (data + sizeof (Header) + entriesSize);
+  return true;
+}
+
+/////////////////////////////////////////////////
+uint32_t MappedTextureAtlas::size () const
+{
+  return mHeader.entriesCount;
+}
+
+/////////////////////////////////////////////////
+uint32_t MappedTextureAtlas::texturesCount () const
+{
+  return mHeader.texturesCount;
+}
+
+/////////////////////////////////////////////////
+std::string_view MappedTextureAtlas::name (const uint32_t index) const
+{
+  if (index >= mHeader.entriesCount) {
+    return {};
+  }
+  // clamp name to the names table, in case of a corrupted entry
+  const auto& entry = mEntries [index];
+  const auto offset = std::min (entry.nameOffset, mHeader.namesSize);
+  const auto size = std::min (entry.nameSize, mHeader.namesSize - offset);
+  return std::string_view (mNames + offset, size);
+}
+
+/////////////////////////////////////////////////
+Frames MappedTextureAtlas::frames (const uint32_t index) const
+{
+  auto frames = Frames ();
+  if (index < mHeader.entriesCount) {
+    const auto& entry = mEntries [index];
+    frames.count = entry.count;
+    frames.texture = sf::IntRect ({entry.left, entry.top}, {entry.width, entry.height});
+  }
+  return frames;
+}
+
+/////////////////////////////////////////////////
+std::optional <uint32_t> MappedTextureAtlas::find (std::string_view entry) const
+{
+  // binary search in the sorted names
+  auto first = 0u;
+  auto last = mHeader.entriesCount;
+  while (first < last) {
+    const auto middle = first + (last - first) / 2;
+    const auto comparison = name (middle).compare (entry);
+    if (comparison == 0) {
+      return middle;
+    }
+    if (comparison < 0) {
+      first = middle + 1;
+    } else {
+      last = middle;
+    }
+  }
+  return std::nullopt;
+}
+
+/////////////////////////////////////////////////
+std::optional <sf::IntRect> MappedTextureAtlas::textureRect (
+  std::string_view entry,
+  const uint32_t frame) const
+{
+  const auto func = std::string ("MappedTextureAtlas::textureRect :");
+  // check that entry exist
+  const auto index = find (entry);
+  if (!index) {
+    spdlog::error ("{} {} is not a valid entry in the atlas, will return null texture", func, entry);
+    return std::nullopt;
+  }
+  // check that frame is in range, return first frame if not
+  const auto texture = frames (*index);
+  if (frame >= texture.count) {
+    spdlog::warn ("{} Trying to access frame out of the animation, will return frame 0", func);
+    return std::optional (texture.texture);
+  }
+  // return asked frame
+  const auto shift = sf::Vector2i (texture.texture.size.x * frame, 0);
+  return std::optional (
+    sf::IntRect (texture.texture.position + shift, texture.texture.size)
+  );
+}
+
+} // namespace sgui
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <SFML/Graphics/Rect.hpp>
+
+#include "sgui/Core/MappedFile.h"
+#include "sgui/Resources/TextureAtlas.h"
+
+namespace sgui
+{
+/**
+ * @brief Read-only texture atlas stored in a compact binary file. The file is
+ * memory-mapped and used as it is, entries are never parsed nor copied, which
+ * makes loading of atlases with many sprites immediate. Binary atlases are
+ * written from a TextureAtlas with saveInBinaryFile or converted from json
+ * with convertTextureAtlas.
+ *
+ * File layout, in native byte order:
+ *    - Header
+ *    - Entry [entriesCount], sorted by name
+ *    - names, concatenated without separator
+ */
+class MappedTextureAtlas
+{
+public:
+  /**
+   * @brief binary atlas header
+   */
+  struct Header {
+    char magic [4] = { 'S', 'G', 'T', 'A' };
+    uint32_t version = 1u;
+    uint32_t entriesCount = 0u; ///< Number of textures names
+    uint32_t texturesCount = 0u; ///< Number of frames, summed over all entries
+    uint32_t namesSize = 0u; ///< Size in bytes of the names table
+  };
+  /**
+   * @brief binary atlas entry, its name is a slice of the names table
+   */
+  struct Entry {
+    uint32_t nameOffset = 0u;
+    uint32_t nameSize = 0u;
+    int32_t left = 0;
+    int32_t top = 0;
+    int32_t width = 0;
+    int32_t height = 0;
+    uint32_t count = 1u; ///< Frames count
+  };
+  static constexpr uint32_t Version = 1u;
+public:
+  /**
+   * @brief Build an empty atlas
+   */
+  MappedTextureAtlas () = default;
+  /**
+   * @brief Map a binary texture atlas
+   * @param filename File from which atlas is mapped
+   */
+  MappedTextureAtlas (const std::string& filename);
+  /**
+   * @brief Map a binary texture atlas, the previous one is unmapped
+   * @param filename File from which atlas is mapped
+   * @return `true` if the file is a valid binary atlas
+   */
+  bool loadFromFile (const std::string& filename);
+  /**
+   * @brief Use a binary texture atlas stored in memory, e.g. in an AssetBundle.
+   *   Memory is not copied, it must outlive the atlas.
+   * @param data Bytes of the atlas, they must be 4 bytes aligned
+   * @param size Size in bytes of the atlas
+   * @return `true` if data is a valid binary atlas
+   */
+  bool loadFromMemory (const std::byte* data, const size_t size);
+  /**
+   * @brief Get number of entries, i.e. of textures names
+   */
+  uint32_t size () const;
+  /**
+   * @brief Get number of textures stored in the atlas, frames included
+   */
+  uint32_t texturesCount () const;
+  /**
+   * @brief Get index of an entry, entries are sorted by name
+   * @param entry Texture name
+   * @return Index of the entry, `std::nullopt` if it's not in the atlas
+   */
+  std::optional <uint32_t> find (std::string_view entry) const;
+  /**
+   * @brief Get name of the entry at index, it views the mapped file
+   */
+  std::string_view name (const uint32_t index) const;
+  /**
+   * @brief Get frames count and first frame of the entry at index
+   */
+  Frames frames (const uint32_t index) const;
+  /**
+   * @brief Get texture rect of an entry, if the entry exist
+   * @param entry Texture name
+   * @param frame Texture frame it its part of an animation
+   * @return Texture rect if it's stored in the atlas, `std::nullopt` otherwise
+   */
+  std::optional <sf::IntRect> textureRect (std::string_view entry, const uint32_t frame = 0) const;
+private:
+  const Entry* mEntries = nullptr;
+  const char* mNames = nullptr;
+  Header mHeader = {};
+  MappedFile mFile;
+};
+
+} // namespace sgui
@@ -1,14 +1,77 @@
 #pragma once
 
+#include <tuple>
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <exception>
 #include <vector>
 #include <memory>
+#include <optional>
 #include <string>
 #include <cassert>
+#include <functional>
 #include <unordered_map>
 #include <spdlog/spdlog.h>
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/Graphics/Image.hpp>
+
+#include "sgui/Core/ThreadPool.h"
 
 namespace sgui
 {
+/**
+ * @brief state of an asynchronous load
+ */
+enum class LoadStatus : uint8_t {
+  Pending,  ///< Queued or being decoded by a worker
+  Decoded,  ///< Decoded, waiting to be finalized on the main thread
+  Loaded,   ///< Stored in the holder
+  Failed    ///< Failed to load, nothing was stored
+};
+
+/**
+ * @brief handle on an asynchronous load, it can be polled or waited from any thread
+ */
+class LoadHandle
+{
+public:
+  LoadHandle () = default;
+  /**
+   * @brief get load status
+   */
+  LoadStatus status () const { return mState ? mState->status.load () : LoadStatus::Failed; }
+  /**
+   * @brief test if the load is over, either stored or failed
+   */
+  bool isDone () const { return status () == LoadStatus::Loaded || status () == LoadStatus::Failed; }
+  /**
+   * @brief block until the background part is done. The resource is only stored
+   *   once finalized on the main thread, with ResourcesHolder::finalize or wait.
+   */
+  void wait () const { if (mState && mState->decoded.valid ()) { mState->decoded.wait (); } }
+private:
+  template <typename Resource, typename Identifier>
+  friend class ResourcesHolder;
+  struct State {
+    std::atomic <LoadStatus> status = LoadStatus::Pending;
+    std::shared_future <void> decoded;
+  };
+  std::shared_ptr <State> mState;
+};
+
+/**
+ * @brief load statistics of a holder, times are in seconds
+ */
+struct LoadStatistics {
+  uint32_t loaded = 0u;
+  uint32_t failed = 0u;
+  float loadTime = 0.f;      ///< Time spent reading and decoding files, summed over all loads
+  float longestLoad = 0.f;   ///< Longest time spent reading and decoding one file
+  float finalizeTime = 0.f;  ///< Time spent on the main thread to finalize asynchronous loads
+};
+
 /**
  * @brief load and hold resources of all kind (image, music, etc.), that can be
  *  retrieved with Identifier that are comparable. Note that Resource should 
@@ -43,7 +106,66 @@ public:
    * @brief get mutable resource from its identifier, return first element if id was not registered
    */
   Resource& get (const Identifier& id);
+  /**
+   * @brief load resource from file on a worker of pool. Files are read and
+   *   decoded in the background, the resource is then stored on the main thread
+   *   by finalize, where textures are uploaded and shaders compiled. Until
+   *   then, get returns the placeholder. Extra arguments are copied, for
+   *   textures they are given to loadFromImage.
+   * @return handle to poll or wait the load
+   */
+  template <typename... Parameters>
+  LoadHandle loadAsync (
+         ThreadPool& pool,
+         const Identifier& id,
+         const std::string& filename,
+         Parameters&&... args);
+  /**
+   * @brief store decoded resources, it must be called from the main thread,
+   *   typically once per frame. At least one load is finalized, then it stops
+   *   as soon as budget is exceeded.
+   * @return number of loads finalized
+   */
+  uint32_t finalize (const sf::Time budget = sf::milliseconds (2));
+  /**
+   * @brief wait for an asynchronous load and finalize it, from the main thread
+   * @return true if the resource was stored
+   */
+  bool wait (const LoadHandle& handle);
+  /**
+   * @brief test if a resource is being loaded asynchronously
+   */
+  bool isLoading (const Identifier& id) const;
+  /**
+   * @brief use a loaded resource as placeholder for resources being loaded
+   */
+  void setPlaceholder (const Identifier& id);
+  /**
+   * @brief get load statistics of this resource type
+   */
+  const LoadStatistics& statistics () const;
 private:
+  // asynchronous load shared with a worker, worker fields are published by status
+  struct PendingLoad {
+    Identifier id;
+    std::string filename;
+    std::shared_ptr <LoadHandle::State> state;
+    std::function <bool (Resource&)> load;
+    std::function <bool (Resource&, const sf::Image&)> upload;
+    std::unique_ptr <Resource> resource;
+    std::unique_ptr <sf::Image> image;
+    float loadTime = 0.f;
+  };
+  // Load resource from file
+  template <typename... Parameters>
+  static bool loadResource (
+         Resource& resource,
+         const std::string& filename,
+         Parameters&&... args);
+  // Store a decoded load in the holder
+  bool finalizeLoad (PendingLoad& pending);
+  // Update statistics with a load
+  void record (const bool success, const float loadTime);
   // Hold resource and check that it has a unique id
   void holdResource (
          std::unique_ptr <Resource>&& resource,
@@ -53,6 +175,9 @@ private:
   std::unordered_map <Identifier, std::vector <std::string>> m_filesPath;
   using PtrResource = std::unique_ptr <Resource>;
   std::unordered_map <Identifier, PtrResource> m_resources;
+  std::vector <std::shared_ptr <PendingLoad>> m_pending;
+  std::optional <Identifier> m_placeholder;
+  LoadStatistics m_statistics;
 };
 
 } // namespace sgui
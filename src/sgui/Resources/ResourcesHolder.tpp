@@ -13,7 +13,10 @@ bool ResourcesHolder <Resource, Identifier>::load (
     // add data to the previously loaded ones
     const auto res = m_resources.find (id);
     if (res != std::end (m_resources)) {
-      if (!res->second->loadFromFile (filename, std::forward <Args> (args)...)) {
+      auto clock = sf::Clock ();
+      const auto success = res->second->loadFromFile (filename, std::forward <Args> (args)...);
+      record (success, clock.getElapsedTime ().asSeconds ());
+      if (!success) {
         return false;
       }
       // store file name for reload
@@ -22,15 +25,12 @@ bool ResourcesHolder <Resource, Identifier>::load (
     }
   }
   // For all other type, information are stored in one file
+  auto clock = sf::Clock ();
   auto newRes = std::make_unique <Resource> ();
-  if constexpr (std::is_same_v <Resource, sf::Font>) {
-    if (!newRes->openFromFile (filename, std::forward <Args> (args)...)) {
-      return false;
-    }
-  } else {
-    if (!newRes->loadFromFile (filename, std::forward <Args> (args)...)) {
-      return false;
-    }
+  const auto success = loadResource (*newRes, filename, std::forward <Args> (args)...);
+  record (success, clock.getElapsedTime ().asSeconds ());
+  if (!success) {
+    return false;
   }
   // hold it
   holdResource (std::move (newRes), id, filename);
@@ -77,6 +77,14 @@ const Resource& ResourcesHolder <Resource, Identifier>::get (const Identifier& i
   if (resource != std::end (m_resources)) {
     return *(resource->second);
   }
+  // Return placeholder while resource is loading
+  if (isLoading (id)) {
+    const auto placeholder = m_placeholder ? m_resources.find (*m_placeholder) : std::end (m_resources);
+    if (placeholder != std::end (m_resources)) {
+      return *(placeholder->second);
+    }
+    return *(std::begin (m_resources)->second);
+  }
   spdlog::error ("ResourcesHolder::get (): can't find resource {}, will return first element", id);
   return *(std::begin (m_resources)->second);
 }
@@ -89,6 +97,210 @@ Resource& ResourcesHolder <Resource, Identifier>::get (const Identifier& id)
 }
 
 
+/////////////////////////////////////////////////
+// Asynchronous loading
+/////////////////////////////////////////////////
+template <typename Resource, typename Identifier>
+template <typename... Args>
+LoadHandle ResourcesHolder <Resource, Identifier>::loadAsync (
+  ThreadPool& pool,
+  const Identifier& id,
+  const std::string& filename,
+  Args&&... args)
+{
+  auto pending = std::make_shared <PendingLoad> ();
+  pending->id = id;
+  pending->filename = filename;
+  pending->state = std::make_shared <LoadHandle::State> ();
+  auto arguments = std::make_tuple (std::forward <Args> (args)...);
+  if constexpr (std::is_same_v <Resource, sf::Texture>) {
+    // texture arguments (sRGB, area) are given to the upload of the decoded image
+    pending->upload = [arguments] (Resource& texture, const sf::Image& image) {
+      return std::apply ([&] (const auto&... values) {
+        return texture.loadFromImage (image, values...);
+      }, arguments);
+    };
+  } else {
+    pending->load = [filename, arguments] (Resource& resource) {
+      return std::apply ([&] (const auto&... values) {
+        return loadResource (resource, filename, values...);
+      }, arguments);
+    };
+  }
+  // textures are decoded in an image and uploaded on the main thread, shaders
+  // are compiled on the main thread too, as they need the graphic context.
+  // Other resources are loaded in the background.
+  auto task = [pending] () {
+    auto clock = sf::Clock ();
+    auto success = true;
+    // an exception would be kept in the future and leave the load pending forever
+    try {
+      if constexpr (std::is_same_v <Resource, sf::Texture>) {
+        pending->image = std::make_unique <sf::Image> ();
+        success = pending->image->loadFromFile (pending->filename);
+      } else if constexpr (!std::is_same_v <Resource, sf::Shader>) {
+        pending->resource = std::make_unique <Resource> ();
+        success = pending->load (*pending->resource);
+      }
+    } catch (const std::exception& error) {
+      spdlog::error ("ResourcesHolder::loadAsync (): unable to load {}, {}", pending->filename, error.what ());
+      success = false;
+    }
+    pending->loadTime = clock.getElapsedTime ().asSeconds ();
+    pending->state->status = success ? LoadStatus::Decoded : LoadStatus::Failed;
+  };
+  pending->state->decoded = pool.submit (std::move (task)).share ();
+  m_pending.push_back (pending);
+
+  auto handle = LoadHandle ();
+  handle.mState = pending->state;
+  return handle;
+}
+
+/////////////////////////////////////////////////
+template <typename Resource, typename Identifier>
+uint32_t ResourcesHolder <Resource, Identifier>::finalize (const sf::Time budget)
+{
+  // finalize decoded loads in order, until budget is exceeded
+  auto clock = sf::Clock ();
+  auto count = 0u;
+  auto pending = std::begin (m_pending);
+  while (pending != std::end (m_pending)) {
+    if (count > 0 && clock.getElapsedTime () > budget) {
+      break;
+    }
+    if ((*pending)->state->status == LoadStatus::Pending) {
+      pending++;
+      continue;
+    }
+    finalizeLoad (**pending);
+    pending = m_pending.erase (pending);
+    count++;
+  }
+  m_statistics.finalizeTime += clock.getElapsedTime ().asSeconds ();
+  return count;
+}
+
+/////////////////////////////////////////////////
+template <typename Resource, typename Identifier>
+bool ResourcesHolder <Resource, Identifier>::wait (const LoadHandle& handle)
+{
+  const auto pending = std::find_if (std::begin (m_pending), std::end (m_pending),
+    [&handle] (const auto& load) { return load->state == handle.mState; });
+  if (pending == std::end (m_pending)) {
+    return handle.status () == LoadStatus::Loaded;
+  }
+  // wait worker and finalize this load only
+  handle.wait ();
+  auto clock = sf::Clock ();
+  const auto load = *pending;
+  m_pending.erase (pending);
+  const auto success = finalizeLoad (*load);
+  m_statistics.finalizeTime += clock.getElapsedTime ().asSeconds ();
+  return success;
+}
+
+/////////////////////////////////////////////////
+template <typename Resource, typename Identifier>
+bool ResourcesHolder <Resource, Identifier>::isLoading (const Identifier& id) const
+{
+  return std::any_of (std::begin (m_pending), std::end (m_pending),
+    [&id] (const auto& load) { return load->id == id; });
+}
+
+/////////////////////////////////////////////////
+template <typename Resource, typename Identifier>
+void ResourcesHolder <Resource, Identifier>::setPlaceholder (const Identifier& id)
+{
+  if (m_resources.find (id) == std::end (m_resources)) {
+    spdlog::warn ("ResourcesHolder::setPlaceholder (): resource {} is not loaded", id);
+  }
+  m_placeholder = id;
+}
+
+/////////////////////////////////////////////////
+template <typename Resource, typename Identifier>
+const LoadStatistics& ResourcesHolder <Resource, Identifier>::statistics () const
+{
+  return m_statistics;
+}
+
+/////////////////////////////////////////////////
+template <typename Resource, typename Identifier>
+template <typename... Args>
+bool ResourcesHolder <Resource, Identifier>::loadResource (
+  Resource& resource,
+  const std::string& filename,
+  Args&&... args)
+{
+  if constexpr (std::is_same_v <Resource, sf::Font>) {
+    return resource.openFromFile (filename, std::forward <Args> (args)...);
+  } else {
+    return resource.loadFromFile (filename, std::forward <Args> (args)...);
+  }
+}
+
+/////////////////////////////////////////////////
+template <typename Resource, typename Identifier>
+bool ResourcesHolder <Resource, Identifier>::finalizeLoad (PendingLoad& pending)
+{
+  auto success = pending.state->status == LoadStatus::Decoded;
+  auto loadTime = pending.loadTime;
+  const auto existing = m_resources.find (pending.id);
+  if (success) {
+    // Layout or TextContainer data are merged in the previously loaded ones
+    if constexpr (std::is_same_v <Resource, Layout>) {
+      if (existing != std::end (m_resources)) {
+        existing->second->merge (std::move (*pending.resource));
+        m_filesPath.at (pending.id).push_back (pending.filename);
+        pending.resource.reset ();
+      }
+    } else if constexpr (std::is_same_v <Resource, TextContainer>) {
+      if (existing != std::end (m_resources)) {
+        success = existing->second->merge (std::move (*pending.resource));
+        m_filesPath.at (pending.id).push_back (pending.filename);
+        pending.resource.reset ();
+      }
+    }
+    // upload texture or compile shader
+    if constexpr (std::is_same_v <Resource, sf::Texture>) {
+      pending.resource = std::make_unique <Resource> ();
+      success = pending.upload (*pending.resource, *pending.image);
+      pending.image.reset ();
+    } else if constexpr (std::is_same_v <Resource, sf::Shader>) {
+      auto clock = sf::Clock ();
+      pending.resource = std::make_unique <Resource> ();
+      success = pending.load (*pending.resource);
+      loadTime = clock.getElapsedTime ().asSeconds ();
+    }
+  }
+  // hold it
+  if (success && pending.resource) {
+    holdResource (std::move (pending.resource), pending.id, pending.filename);
+  }
+  if (!success) {
+    spdlog::error ("ResourcesHolder::finalize (): unable to load {} from {}", pending.id, pending.filename);
+  }
+  record (success, loadTime);
+  pending.state->status = success ? LoadStatus::Loaded : LoadStatus::Failed;
+  return success;
+}
+
+/////////////////////////////////////////////////
+template <typename Resource, typename Identifier>
+void ResourcesHolder <Resource, Identifier>::record (
+  const bool success,
+  const float loadTime)
+{
+  if (success) {
+    m_statistics.loaded++;
+  } else {
+    m_statistics.failed++;
+  }
+  m_statistics.loadTime += loadTime;
+  m_statistics.longestLoad = std::max (m_statistics.longestLoad, loadTime);
+}
+
 /////////////////////////////////////////////////
 template <typename Resource, typename Identifier>
 void ResourcesHolder <Resource, Identifier>::holdResource (
@@ -3,10 +3,17 @@
 
 namespace sgui
 {
+/////////////////////////////////////////////////
+SoundPlayer::SoundPlayer (const uint32_t voicesCount)
+{
+  setVoicesCount (voicesCount);
+}
+
 /////////////////////////////////////////////////
 void SoundPlayer::setResource (SoundHolder& holder)
 {
   m_soundBuffer = &holder;
+  m_lastPlayed.clear ();
 }
 
 /////////////////////////////////////////////////
@@ -14,23 +21,126 @@ void SoundPlayer::play (
   const std::string& soundIdentifier,
   const sf::Vector2f& position)
 {
-  // add sound to the list of the played one
-  m_sounds.push_back (sf::Sound (m_soundBuffer->get (soundIdentifier)));
+  if (!m_soundBuffer || m_voices.empty ()) {
+    return;
+  }
+  // skip sound if it was played too recently
+  const auto& buffer = m_soundBuffer->get (soundIdentifier);
+  const auto now = m_clock.getElapsedTime ().asSeconds ();
+  const auto lastPlayed = m_lastPlayed.find (&buffer);
+  if (lastPlayed != std::end (m_lastPlayed) && now - lastPlayed->second < minInterval) {
+    m_statistics.limited++;
+    return;
+  }
+  m_lastPlayed [&buffer] = now;
+
+  // reuse a voice, its source is only created the first time
+  auto& voice = m_voices [acquire ()];
+  if (voice.sound) {
+    voice.sound->setBuffer (buffer);
+  } else {
+    voice.sound.emplace (buffer);
+  }
   // set sound position and attenuation
-  auto& sound = m_sounds.back ();
+  auto& sound = *voice.sound;
   sound.setPosition ({position.x, 0.f, position.y});
   sound.setAttenuation (attenuation);
   sound.setMinDistance (minDistance);
   // play requested sound
   sound.play ();
+  m_statistics.played++;
 }
 
 /////////////////////////////////////////////////
 void SoundPlayer::removeStoppedSounds ()
 {
-  m_sounds.remove_if ([] (const auto& sound) {
-    return sound.getStatus () == sf::SoundSource::Status::Stopped;
-  });
+  auto voice = m_oldest;
+  while (voice != NoVoice) {
+    const auto next = m_voices [voice].next;
+    if (m_voices [voice].sound->getStatus () == sf::SoundSource::Status::Stopped) {
+      release (voice);
+    }
+    voice = next;
+  }
+}
+
+/////////////////////////////////////////////////
+void SoundPlayer::stop ()
+{
+  while (m_oldest != NoVoice) {
+    const auto voice = m_oldest;
+    m_voices [voice].sound->stop ();
+    release (voice);
+  }
+}
+
+/////////////////////////////////////////////////
+void SoundPlayer::setVoicesCount (const uint32_t count)
+{
+  stop ();
+  m_voices = std::vector <Voice> (count);
+  m_freeVoices.clear ();
+  m_freeVoices.reserve (count);
+  for (uint32_t voice = count; voice > 0; voice--) {
+    m_freeVoices.push_back (voice - 1);
+  }
+}
+
+/////////////////////////////////////////////////
+uint32_t SoundPlayer::voicesCount () const
+{
+  return static_cast <uint32_t> (m_voices.size ());
+}
+
+/////////////////////////////////////////////////
+const VoiceStatistics& SoundPlayer::statistics () const
+{
+  return m_statistics;
+}
+
+/////////////////////////////////////////////////
+uint32_t SoundPlayer::acquire ()
+{
+  // steal the oldest voice if they are all busy
+  if (m_freeVoices.empty ()) {
+    const auto oldest = m_oldest;
+    m_voices [oldest].sound->stop ();
+    release (oldest);
+    m_statistics.stolen++;
+  }
+  // link voice as the newest
+  const auto voice = m_freeVoices.back ();
+  m_freeVoices.pop_back ();
+  m_voices [voice].previous = m_newest;
+  m_voices [voice].next = NoVoice;
+  if (m_newest != NoVoice) {
+    m_voices [m_newest].next = voice;
+  } else {
+    m_oldest = voice;
+  }
+  m_newest = voice;
+  m_statistics.active++;
+  return voice;
+}
+
+/////////////////////////////////////////////////
+void SoundPlayer::release (const uint32_t voice)
+{
+  auto& released = m_voices [voice];
+  if (released.previous != NoVoice) {
+    m_voices [released.previous].next = released.next;
+  } else {
+    m_oldest = released.next;
+  }
+  if (released.next != NoVoice) {
+    m_voices [released.next].previous = released.previous;
+  } else {
+    m_newest = released.previous;
+  }
+  released.previous = NoVoice;
+  released.next = NoVoice;
+  m_freeVoices.push_back (voice);
+  m_statistics.active--;
 }
 
 /////////////////////////////////////////////////
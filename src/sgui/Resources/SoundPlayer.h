@@ -1,6 +1,9 @@
 #pragma once
 
-#include <list>
+#include <vector>
+#include <optional>
+#include <unordered_map>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/Vector3.hpp>
 #include <SFML/Audio/Sound.hpp>
@@ -11,7 +14,19 @@
 namespace sgui
 {
 /**
- * @brief Allow to play spatialized sounds
+ * @brief Voices usage of a SoundPlayer
+ */
+struct VoiceStatistics {
+  uint32_t active = 0u;  ///< Voices currently playing
+  uint32_t played = 0u;  ///< Sounds played since the creation of the player
+  uint32_t stolen = 0u;  ///< Sounds stopped to play a new one, as all voices were busy
+  uint32_t limited = 0u; ///< Sounds skipped as the same sound was played too recently
+};
+
+/**
+ * @brief Allow to play spatialized sounds. Sounds are played on a fixed
+ * number of voices, that are created once and reused. When all voices are
+ * busy, the oldest sound is stopped to play the new one.
  */
 class SoundPlayer
 {
@@ -19,7 +34,7 @@ public:
   /**
    * SoundPlayer is not copyable
    */
-  SoundPlayer () = default;
+  SoundPlayer (const uint32_t voicesCount = 16u);
   SoundPlayer (const SoundPlayer&) = delete;
   SoundPlayer& operator= (const SoundPlayer&) = delete;
   /**
@@ -27,15 +42,32 @@ public:
    */
   void setResource (SoundHolder& holder);
   /**
-   * @brief play a sound at a given position
+   * @brief play a sound at a given position, it's skipped if the same sound
+   *   was played less than minInterval seconds ago
    */
   void play (
          const std::string& sound,
          const sf::Vector2f& position = {});
   /**
-   * @brief remove all stopped sounds
+   * @brief free voices of stopped sounds
    */
   void removeStoppedSounds ();
+  /**
+   * @brief stop all sounds
+   */
+  void stop ();
+  /**
+   * @brief set number of voices, this stop all sounds
+   */
+  void setVoicesCount (const uint32_t count);
+  /**
+   * @brief get number of voices
+   */
+  uint32_t voicesCount () const;
+  /**
+   * @brief get voices usage
+   */
+  const VoiceStatistics& statistics () const;
   /**
    * @brief get listener position
    */
@@ -55,9 +87,28 @@ public:
 public:
   float attenuation = 0.f;
   float minDistance = 100.f;
+  float minInterval = 0.03f; ///< Minimum time in seconds between two plays of a sound
+private:
+  static constexpr uint32_t NoVoice = ~uint32_t (0);
+  // voices playing are linked from the oldest to the newest
+  struct Voice {
+    std::optional <sf::Sound> sound;
+    uint32_t previous = NoVoice;
+    uint32_t next = NoVoice;
+  };
+  // get a free voice, or steal the oldest one
+  uint32_t acquire ();
+  // unlink a voice and make it free
+  void release (const uint32_t voice);
 private:
-  SoundHolder* m_soundBuffer;
-  std::list <sf::Sound> m_sounds;
+  SoundHolder* m_soundBuffer = nullptr;
+  std::vector <Voice> m_voices;
+  std::vector <uint32_t> m_freeVoices;
+  uint32_t m_oldest = NoVoice;
+  uint32_t m_newest = NoVoice;
+  sf::Clock m_clock;
+  std::unordered_map <const sf::SoundBuffer*, float> m_lastPlayed;
+  VoiceStatistics m_statistics;
 };
 
 } // namespace sgui
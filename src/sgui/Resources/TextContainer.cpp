@@ -1,9 +1,74 @@
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <filesystem>
 #include <spdlog/spdlog.h>
 #include "sgui/Resources/TextContainer.h"
 #include "sgui/Serialization/LoadLookupTable.h"
 
 namespace sgui
 {
+namespace
+{
+/**
+ * binary catalog layout, in native byte order: header, entries sorted by key
+ * and strings, keys and texts are slices of the strings table
+ */
+struct CatalogHeader {
+  char magic [4] = { 'S', 'G', 'T', 'C' };
+  uint32_t version = 1u;
+  uint32_t entriesCount = 0u;
+  uint32_t stringsSize = 0u;
+};
+
+struct CatalogEntry {
+  uint32_t keyOffset = 0u;
+  uint32_t keySize = 0u;
+  uint32_t textOffset = 0u;
+  uint32_t textSize = 0u;
+};
+
+constexpr auto CatalogVersion = 1u;
+
+/////////////////////////////////////////////////
+bool isCatalog (const MappedFile& file)
+{
+  if (file.size () < sizeof (CatalogHeader)) {
+    return false;
+  }
+  return std::memcmp (file.data (), CatalogHeader ().magic, sizeof (CatalogHeader::magic)) == 0;
+}
+
+/////////////////////////////////////////////////
+CatalogHeader header (const MappedFile& catalog)
+{
+  auto header = CatalogHeader ();
+  std::memcpy (&header, catalog.data (), sizeof (CatalogHeader));
+  return header;
+}
+
+/////////////////////////////////////////////////
+const CatalogEntry* entries (const MappedFile& catalog)
+{
+  return reinterpret_cast<const CatalogEntry*> (catalog.data () + sizeof (CatalogHeader));
+}
+
+/////////////////////////////////////////////////
+std::string_view slice (
+  const MappedFile& catalog,
+  const uint32_t offset,
+  const uint32_t size)
+{
+  // clamp slice to the strings table, in case of a corrupted entry
+  const auto stringsSize = header (catalog).stringsSize;
+  const auto start = sizeof (CatalogHeader) + header (catalog).entriesCount * sizeof (CatalogEntry);
+  const auto first = std::min (offset, stringsSize);
+  const auto count = std::min (size, stringsSize - first);
+  return std::string_view (reinterpret_cast<const char*> (catalog.data () + start + first), count);
+}
+
+} // namespace
+
 /////////////////////////////////////////////////
 const std::string& TextContainer::tongue () const
 {
@@ -14,6 +79,15 @@ const std::string& TextContainer::tongue () const
 void TextContainer::setTongue (const std::string& tongue)
 {
   m_activeTongue = tongue;
+  // load tongue files the first time it's used
+  auto& texts = active ();
+  if (!texts.loaded) {
+    texts.loaded = true;
+    for (const auto& path : texts.paths) {
+      load (texts, path);
+    }
+  }
+  resolveAll ();
 }
 
 /////////////////////////////////////////////////
@@ -24,11 +98,22 @@ bool TextContainer::reload (const std::string& tongue)
   if (tongue == "") {
     loadingTongue = m_activeTongue;
   }
+  const auto texts = m_tongues.find (loadingTongue);
+  if (texts == std::end (m_tongues)) {
+    spdlog::warn ("TextContainer::reload : no files for tongue {}", loadingTongue);
+    return false;
+  }
 
   // load all files stored for the selected tongue
   auto success = true;
-  for (const auto& paths : m_paths.at (loadingTongue)) {
-    success = sgui::loadFromFile (m_texts.at (loadingTongue), paths) && success;
+  texts->second.loaded = true;
+  texts->second.catalogs.clear ();
+  texts->second.copies.clear ();
+  for (const auto& path : texts->second.paths) {
+    success = load (texts->second, path) && success;
+  }
+  if (loadingTongue == m_activeTongue) {
+    resolveAll ();
   }
   return success;
 }
@@ -44,23 +129,73 @@ bool TextContainer::loadFromFile (
     loadingTongue = m_activeTongue;
   }
 
-  // check that lookup-tables exist for the loading tongue
-  if (m_texts.find (loadingTongue) == std::end (m_texts)) {
-    m_texts.insert ({loadingTongue, {}});
-  }
-  if (m_paths.find (loadingTongue) == std::end (m_paths)) {
-    m_paths.insert ({loadingTongue, {}});
+  // other tongues are only loaded when they are used
+  auto& texts = m_tongues [loadingTongue];
+  texts.paths.push_back (filename);
+  if (loadingTongue != m_activeTongue && !texts.loaded) {
+    return std::filesystem::exists (filename);
   }
 
   // load filename
-  m_paths.at (loadingTongue).push_back (filename);
-  return sgui::loadFromFile (m_texts.at (loadingTongue), filename);
+  texts.loaded = true;
+  const auto success = load (texts, filename);
+  if (loadingTongue == m_activeTongue) {
+    resolveAll ();
+  }
+  return success;
+}
+
+/////////////////////////////////////////////////
+bool TextContainer::merge (TextContainer&& other)
+{
+  auto success = true;
+  for (auto& [name, tongue] : other.m_tongues) {
+    auto& texts = m_tongues [name];
+    // decoded texts are complete only if no file of this tongue is left to load
+    const auto complete = texts.loaded || texts.paths.empty ();
+    texts.paths.insert (std::end (texts.paths), std::begin (tongue.paths), std::end (tongue.paths));
+    if (!complete) {
+      continue;
+    }
+    // files of a tongue that was not decoded are loaded now
+    if (!tongue.loaded) {
+      if (texts.loaded) {
+        for (const auto& path : tongue.paths) {
+          success = load (texts, path) && success;
+        }
+      }
+      continue;
+    }
+    texts.loaded = true;
+    for (auto& text : tongue.texts) {
+      texts.texts.insert_or_assign (text.first, std::move (text.second));
+    }
+    for (auto& catalog : tongue.catalogs) {
+      texts.catalogs.push_back (std::move (catalog));
+    }
+    texts.copies.clear ();
+  }
+  resolveAll ();
+  return success;
 }
 
 /////////////////////////////////////////////////
 void TextContainer::saveInFile (const std::string& filename)
 {
-  sgui::saveInFile (m_texts.at (m_activeTongue), filename);
+  // write catalogs texts too, json texts take precedence
+  const auto& texts = active ();
+  auto out = texts.texts;
+  for (const auto& catalog : texts.catalogs) {
+    const auto count = header (catalog).entriesCount;
+    for (uint32_t index = 0; index < count; index++) {
+      const auto& entry = entries (catalog) [index];
+      out.insert ({
+        std::string (slice (catalog, entry.keyOffset, entry.keySize)),
+        std::string (slice (catalog, entry.textOffset, entry.textSize))
+      });
+    }
+  }
+  sgui::saveInFile (out, filename);
 }
 
 /////////////////////////////////////////////////
@@ -68,26 +203,91 @@ void TextContainer::add (
   const std::string& key,
   const std::string& text)
 {
-  m_texts.at (m_activeTongue).insert ({key, text});
+  active ().texts.insert ({key, text});
+  // update interned key, if any
+  const auto interned = m_keys.find (key);
+  if (interned != std::end (m_keys)) {
+    m_resolved [interned->second] = resolve (interned->second);
+  }
 }
 
 /////////////////////////////////////////////////
 void TextContainer::remove (const std::string& entry)
 {
-  m_texts.at (m_activeTongue).erase (entry);
+  active ().texts.erase (entry);
+  active ().copies.erase (entry);
+  // update interned key, if any
+  const auto interned = m_keys.find (entry);
+  if (interned != std::end (m_keys)) {
+    m_resolved [interned->second] = resolve (interned->second);
+  }
+}
+
+/////////////////////////////////////////////////
+TextKey TextContainer::key (const std::string& entry)
+{
+  // return already interned key
+  const auto interned = m_keys.find (entry);
+  if (interned != std::end (m_keys)) {
+    return TextKey { interned->second };
+  }
+  // or intern it and resolve its text
+  const auto id = static_cast<uint32_t> (m_keysName.size ());
+  m_keys.insert ({entry, id});
+  m_keysName.push_back (entry);
+  m_resolved.push_back (resolve (id));
+  return TextKey { id };
+}
+
+/////////////////////////////////////////////////
+std::string_view TextContainer::get (const TextKey key) const
+{
+  if (key.id >= m_resolved.size ()) {
+    return {};
+  }
+  const auto& resolved = m_resolved [key.id];
+  if (resolved.text) {
+    return *resolved.text;
+  }
+  if (resolved.view.data ()) {
+    return resolved.view;
+  }
+  return m_keysName [key.id];
 }
 
 /////////////////////////////////////////////////
 std::string& TextContainer::get (const std::string& entry)
 {
+  // catalogs are read-only, so a mutable text is a copy stored with json texts
+  auto& texts = active ();
+  if (texts.texts.find (entry) == std::end (texts.texts)) {
+    const auto text = find (texts, entry);
+    if (text.data ()) {
+      add (entry, std::string (text));
+    }
+  }
   return const_cast <std::string&> (std::as_const (*this).get (entry));
 }
 
 /////////////////////////////////////////////////
 const std::string& TextContainer::get (const std::string& entry) const
 {
-  if (has (entry)) {
-    return m_texts.at (m_activeTongue).at (entry);
+  const auto texts = m_tongues.find (m_activeTongue);
+  if (texts != std::end (m_tongues)) {
+    // json texts
+    const auto text = texts->second.texts.find (entry);
+    if (text != std::end (texts->second.texts)) {
+      return text->second;
+    }
+    // catalogs texts, copied once
+    const auto copy = texts->second.copies.find (entry);
+    if (copy != std::end (texts->second.copies)) {
+      return copy->second;
+    }
+    const auto view = find (texts->second, entry);
+    if (view.data ()) {
+      return texts->second.copies.insert ({entry, std::string (view)}).first->second;
+    }
   }
   spdlog::warn ("TextContainer::get : entry {} doesn't exist, will return entry as is", entry);
   return entry;
@@ -96,11 +296,165 @@ const std::string& TextContainer::get (const std::string& entry) const
 /////////////////////////////////////////////////
 bool TextContainer::has (const std::string& entry) const
 {
-  if (m_texts.find (m_activeTongue) != std::end (m_texts)) {
-    const auto& textsInTongue = m_texts.at (m_activeTongue);
-    return textsInTongue.find (entry) != std::end (textsInTongue);
+  const auto texts = m_tongues.find (m_activeTongue);
+  if (texts != std::end (m_tongues)) {
+    const auto& textsInTongue = texts->second.texts;
+    return textsInTongue.find (entry) != std::end (textsInTongue)
+      || find (texts->second, entry).data () != nullptr;
   }
   return false;
 }
 
+/////////////////////////////////////////////////
+TextContainer::Tongue& TextContainer::active ()
+{
+  return m_tongues [m_activeTongue];
+}
+
+/////////////////////////////////////////////////
+bool TextContainer::load (
+  Tongue& tongue,
+  const std::string& filename)
+{
+  const auto func = std::string ("TextContainer::load :");
+  auto file = MappedFile ();
+  if (!file.open (filename)) {
+    return false;
+  }
+  // json files are parsed and merged, later files override earlier ones
+  if (!isCatalog (file)) {
+    file.close ();
+    auto texts = LookupTable <std::string> ();
+    try {
+      sgui::loadFromFile (texts, filename);
+    } catch (const json::exception& error) {
+      spdlog::error ("{} unable to parse {}, {}", func, filename, error.what ());
+      return false;
+    }
+    for (auto& text : texts) {
+      tongue.texts.insert_or_assign (text.first, std::move (text.second));
+    }
+    return true;
+  }
+  // catalogs are kept mapped, after checking their layout
+  const auto catalog = header (file);
+  const auto size = sizeof (CatalogHeader)
+    + static_cast<uint64_t> (catalog.entriesCount) * sizeof (CatalogEntry) + catalog.stringsSize;
+  if (catalog.version != CatalogVersion || file.size () != size) {
+    spdlog::error ("{} {} is not a valid catalog of version {}", func, filename, CatalogVersion);
+    return false;
+  }
+  tongue.catalogs.push_back (std::move (file));
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::string_view TextContainer::find (
+  const Tongue& tongue,
+  std::string_view entry) const
+{
+  // binary search in catalogs, the last loaded one take precedence
+  for (auto catalog = std::rbegin (tongue.catalogs); catalog != std::rend (tongue.catalogs); catalog++) {
+    const auto first = entries (*catalog);
+    const auto last = first + header (*catalog).entriesCount;
+    const auto found = std::lower_bound (first, last, entry,
+      [&catalog] (const CatalogEntry& lhs, std::string_view rhs) {
+        return slice (*catalog, lhs.keyOffset, lhs.keySize) < rhs;
+      });
+    if (found != last && slice (*catalog, found->keyOffset, found->keySize) == entry) {
+      return slice (*catalog, found->textOffset, found->textSize);
+    }
+  }
+  return {};
+}
+
+/////////////////////////////////////////////////
+TextContainer::ResolvedText TextContainer::resolve (const uint32_t key) const
+{
+  auto resolved = ResolvedText ();
+  const auto texts = m_tongues.find (m_activeTongue);
+  if (texts == std::end (m_tongues)) {
+    return resolved;
+  }
+  const auto& entry = m_keysName [key];
+  const auto text = texts->second.texts.find (entry);
+  if (text != std::end (texts->second.texts)) {
+    resolved.text = &text->second;
+  } else {
+    resolved.view = find (texts->second, entry);
+  }
+  return resolved;
+}
+
+/////////////////////////////////////////////////
+void TextContainer::resolveAll ()
+{
+  for (uint32_t key = 0; key < m_resolved.size (); key++) {
+    m_resolved [key] = resolve (key);
+  }
+}
+
+/////////////////////////////////////////////////
+// catalog compilation
+/////////////////////////////////////////////////
+bool compileTextCatalog (
+  const std::vector <std::string>& files,
+  const std::string& catalog)
+{
+  // load and merge texts, later files override earlier ones
+  auto success = true;
+  auto texts = LookupTable <std::string> ();
+  for (const auto& file : files) {
+    auto fileTexts = LookupTable <std::string> ();
+    try {
+      sgui::loadFromFile (fileTexts, file);
+    } catch (const std::exception& error) {
+      spdlog::error ("compileTextCatalog: unable to load {}, {}", file, error.what ());
+      success = false;
+      continue;
+    }
+    for (auto& text : fileTexts) {
+      texts.insert_or_assign (text.first, std::move (text.second));
+    }
+  }
+
+  // sort keys so that they can be searched in place
+  auto sorted = std::vector <std::pair <std::string_view, std::string_view>> ();
+  sorted.reserve (texts.size ());
+  for (const auto& text : texts) {
+    sorted.emplace_back (text.first, text.second);
+  }
+  std::sort (std::begin (sorted), std::end (sorted));
+
+  // build entries and strings table
+  auto header = CatalogHeader ();
+  auto strings = std::string ();
+  auto entries = std::vector <CatalogEntry> ();
+  entries.reserve (sorted.size ());
+  for (const auto& [key, text] : sorted) {
+    auto entry = CatalogEntry ();
+    entry.keyOffset = static_cast<uint32_t> (strings.size ());
+    entry.keySize = static_cast<uint32_t> (key.size ());
+    strings.append (key);
+    entry.textOffset = static_cast<uint32_t> (strings.size ());
+    entry.textSize = static_cast<uint32_t> (text.size ());
+    strings.append (text);
+    entries.push_back (entry);
+  }
+  header.version = CatalogVersion;
+  header.entriesCount = static_cast<uint32_t> (entries.size ());
+  header.stringsSize = static_cast<uint32_t> (strings.size ());
+
+  // write everything in one go
+  auto out = std::ofstream (catalog, std::ios::binary);
+  out.write (reinterpret_cast<const char*> (&header), sizeof (CatalogHeader));
+  out.write (reinterpret_cast<const char*> (entries.data ()), entries.size () * sizeof (CatalogEntry));
+  out.write (strings.data (), strings.size ());
+  if (!out) {
+    spdlog::error ("compileTextCatalog: unable to write {}", catalog);
+    return false;
+  }
+  return success;
+}
+
 } // namespace sgui
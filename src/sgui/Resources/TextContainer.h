@@ -1,16 +1,37 @@
 #pragma once
 
+#include <deque>
 #include <string>
 #include <vector>
+#include <cstdint>
+#include <string_view>
 #include <unordered_map>
 
+#include "sgui/Core/MappedFile.h"
+
 namespace sgui
 {
 template <typename Type>
 using LookupTable = std::unordered_map <std::string, Type>;
+
+/**
+ * @brief interned text key, it's resolved once with TextContainer::key and
+ *   then used to get texts without hashing any string
+ */
+struct TextKey {
+  static constexpr uint32_t Invalid = ~uint32_t (0);
+  uint32_t id = Invalid;
+  bool isValid () const { return id != Invalid; }
+  bool operator== (const TextKey& other) const { return id == other.id; }
+  bool operator!= (const TextKey& other) const { return id != other.id; }
+};
+
 /**
  * @brief store text accessible with a string key, with option to load and store text
- *   for a given tongue, so it has simple support for localisation.
+ *   for a given tongue, so it has simple support for localisation. Texts can be
+ *   loaded from json files or from binary catalogs compiled with compileTextCatalog,
+ *   which are memory-mapped and never parsed. Only the active tongue is loaded,
+ *   others are loaded the first time they are selected with setTongue.
  */
 class TextContainer {
 public:
@@ -19,7 +40,7 @@ public:
    */
   const std::string& tongue () const;
   /**
-   * @brief set tongue used 
+   * @brief set tongue used, its files are loaded if it's the first time it's used
    */
   void setTongue (const std::string& tongue);
   /**
@@ -27,13 +48,21 @@ public:
    */
   bool reload (const std::string& tongue = "");
   /**
-   * @brief load texts from a filename for this given tongue. By default it uses active tongue.
+   * @brief load texts from a json file or a binary catalog for this given tongue.
+   *   By default it uses active tongue. Files of other tongues are only loaded
+   *   when the tongue is selected, in this case it returns if the file exists.
    */
   bool loadFromFile (
          const std::string& filename,
          const std::string& tongue = "");
   /**
-   * @brief save texts of the current tongue 
+   * @brief add texts of another container, e.g. one loaded in the background.
+   *   Its texts override existing ones and its files are kept for reload.
+   * @return false if a file of a loaded tongue could not be loaded
+   */
+  bool merge (TextContainer&& other);
+  /**
+   * @brief save texts of the current tongue
    */
   void saveInFile (const std::string& filename);
   /**
@@ -46,22 +75,66 @@ public:
    * @brief remove text from the container for the current tongue
    */
   void remove (const std::string& key);
+  /**
+   * @brief intern a text key, the handle stay valid for every tongue
+   */
+  TextKey key (const std::string& entry);
+  /**
+   * @brief get text of an interned key for the current tongue, the key itself
+   *   is returned if it has no text. The view is valid until texts are modified.
+   */
+  std::string_view get (const TextKey key) const;
   /**
    * @brief get mutable text entry for the current tongue
    */
   std::string& get (const std::string& entry);
   /**
-   * @brief get text entry for the current tongue
+   * @brief get text entry for the current tongue, prefer interned keys in
+   *   loops, texts of catalogs are copied the first time they are requested
    */
   const std::string& get (const std::string& entry) const;
   /**
    * @brief check that entry is stored
    */
   bool has (const std::string& entry) const;
+private:
+  // texts of a tongue, json texts take precedence over catalogs ones
+  struct Tongue {
+    bool loaded = false;
+    std::vector <std::string> paths;
+    std::vector <MappedFile> catalogs;
+    LookupTable <std::string> texts;
+    // copies of catalog texts requested with a string
+    mutable LookupTable <std::string> copies;
+  };
+  // text of an interned key, either a stored string or a catalog slice
+  struct ResolvedText {
+    const std::string* text = nullptr;
+    std::string_view view;
+  };
+  Tongue& active ();
+  bool load (Tongue& tongue, const std::string& filename);
+  std::string_view find (const Tongue& tongue, std::string_view entry) const;
+  ResolvedText resolve (const uint32_t key) const;
+  void resolveAll ();
 private:
   std::string m_activeTongue = "english";
-  LookupTable <std::vector <std::string>> m_paths;
-  LookupTable <LookupTable <std::string>> m_texts;
+  LookupTable <Tongue> m_tongues;
+  // interned keys and their text for the active tongue, key names are
+  // returned as views when they have no text, so a deque keeps them in place
+  LookupTable <uint32_t> m_keys;
+  std::deque <std::string> m_keysName;
+  std::vector <ResolvedText> m_resolved;
 };
 
+/**
+ * @brief compile json text files of one tongue into a binary catalog
+ * @param files Json files to compile, later files override earlier ones
+ * @param catalog File in which the catalog is written
+ * @return `true` if all files were loaded and the catalog written
+ */
+bool compileTextCatalog (
+  const std::vector <std::string>& files,
+  const std::string& catalog);
+
 } // namespace sgui
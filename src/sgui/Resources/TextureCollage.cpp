@@ -1,11 +1,178 @@
+#include <cmath>
+#include <memory>
+#include <fstream>
+#include <optional>
 #include <filesystem>
 #include <algorithm>
+#include <spdlog/spdlog.h>
+#include "sgui/Core/ThreadPool.h"
+#include "sgui/Core/MappedFile.h"
+#include "sgui/Serialization/LoadJson.h"
+#include "sgui/Serialization/LoadTextureAtlas.h"
 #include "sgui/Resources/TextureCollage.h"
 
-namespace sgui 
+namespace sgui
 {
 namespace fs = std::filesystem;
 
+namespace
+{
+////////////////////////////////////////////////////////////
+/**
+ * Bottom-left skyline packer, the skyline is the top of the images already
+ * placed, stored as horizontal segments from left to right
+ */
+class Skyline {
+public:
+  explicit Skyline (const uint32_t width)
+    : m_width (width), m_segments ({{0u, 0u, width}})
+  {}
+
+  ////////////////////////////////////////////////////////////
+  std::optional <sf::Vector2u> insert (const sf::Vector2u& size)
+  {
+    // find the position that leave the image top as low as possible
+    auto best = m_segments.size ();
+    auto bestY = 0u;
+    auto bestTop = ~0u;
+    for (size_t i = 0; i < m_segments.size (); i++) {
+      const auto y = fit (i, size.x);
+      if (y && *y + size.y < bestTop) {
+        best = i;
+        bestY = *y;
+        bestTop = *y + size.y;
+      }
+    }
+    if (best == m_segments.size ()) {
+      return std::nullopt;
+    }
+
+    // raise skyline under the image
+    const auto x = m_segments [best].x;
+    m_segments.insert (m_segments.begin () + best, Segment {x, bestTop, size.x});
+    const auto right = x + size.x;
+    for (auto next = best + 1; next < m_segments.size ();) {
+      auto& segment = m_segments [next];
+      if (segment.x >= right) {
+        break;
+      }
+      const auto covered = right - segment.x;
+      if (segment.width <= covered) {
+        m_segments.erase (m_segments.begin () + next);
+      } else {
+        segment.x += covered;
+        segment.width -= covered;
+        break;
+      }
+    }
+    merge ();
+    m_height = std::max (m_height, bestTop);
+    return sf::Vector2u (x, bestY);
+  }
+
+  ////////////////////////////////////////////////////////////
+  uint32_t height () const
+  {
+    return m_height;
+  }
+private:
+  struct Segment {
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+  };
+
+  ////////////////////////////////////////////////////////////
+  // height at which an image of width can be placed on segment i
+  std::optional <uint32_t> fit (const size_t i, const uint32_t width) const
+  {
+    if (m_segments [i].x + width > m_width) {
+      return std::nullopt;
+    }
+    auto y = 0u;
+    auto remaining = static_cast <int64_t> (width);
+    for (auto j = i; remaining > 0 && j < m_segments.size (); j++) {
+      y = std::max (y, m_segments [j].y);
+      remaining -= m_segments [j].width;
+    }
+    return y;
+  }
+
+  ////////////////////////////////////////////////////////////
+  // merge neighbor segments of same height
+  void merge ()
+  {
+    for (size_t i = 0; i + 1 < m_segments.size ();) {
+      if (m_segments [i].y == m_segments [i + 1].y) {
+        m_segments [i].width += m_segments [i + 1].width;
+        m_segments.erase (m_segments.begin () + i + 1);
+      } else {
+        i++;
+      }
+    }
+  }
+private:
+  uint32_t m_width = 0u;
+  uint32_t m_height = 0u;
+  std::vector <Segment> m_segments;
+};
+
+////////////////////////////////////////////////////////////
+bool isImage (const fs::path& file)
+{
+  const auto extension = file.extension ();
+  return extension == ".bmp" || extension == ".png" || extension == ".tga"
+    || extension == ".jpg"  || extension == ".gif" || extension == ".psd"
+    || extension == ".hdr"  || extension == ".pic" || extension == ".pnm";
+}
+
+////////////////////////////////////////////////////////////
+// version of cache files, to be increased if their content change
+constexpr auto CacheVersion = 1;
+
+////////////////////////////////////////////////////////////
+// FNV-1a hash of a file content
+uint64_t hashFile (const fs::path& file)
+{
+  auto hash = uint64_t (14695981039346656037ull);
+  auto mapped = MappedFile ();
+  if (!mapped.open (file.string ())) {
+    return hash;
+  }
+  const auto* data = mapped.data ();
+  for (size_t i = 0; i < mapped.size (); i++) {
+    hash ^= static_cast <uint64_t> (data [i]);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+////////////////////////////////////////////////////////////
+// options that change collage content
+json toJson (const CollageOptions& options)
+{
+  return json {
+    {"useMask", options.useMask},
+    {"maskColor", options.maskColor.toInteger ()},
+    {"padding", options.padding},
+    {"extrude", options.extrude},
+    {"powerOfTwo", options.powerOfTwo}
+  };
+}
+
+////////////////////////////////////////////////////////////
+uint32_t nextPowerOfTwo (const uint32_t value)
+{
+  auto power = 1u;
+  while (power < value) {
+    power *= 2u;
+  }
+  return power;
+}
+
+} // namespace
+
+
 ////////////////////////////////////////////////////////////
 CollageOptions::CollageOptions (const sf::Color& c)
   : useMask (true), maskColor (c)
@@ -17,75 +184,370 @@ TextureCollage::TextureCollage (
   const CollageOptions& options)
   : m_collage (), m_atlas ()
 {
-  // load all images with a valid extension
-  auto totalSurface = 0.f;
-  auto imagesData = std::vector <TextureCollage::ImageInfo> ();
+  // list images with a valid extension, sorted so that collage is reproducible
+  auto files = std::vector <fs::path> ();
   for (const auto& file : fs::directory_iterator (directory)) {
-    const auto extension = file.path ().extension ();
-    if (extension == ".bmp" || extension == ".png" || extension == ".tga" 
-    || extension == ".jpg"  || extension == ".gif" || extension == ".psd"
-    || extension == ".hdr"  || extension == ".pic" || extension == ".pnm") {
-      // load image and store its name
-      imagesData.emplace_back ();
-      auto& info = imagesData.back ();
-      if (info.image.loadFromFile (file)) {
-        info.name = file.path ().stem ().string ();
+    if (isImage (file.path ())) {
+      files.push_back (file.path ());
+    }
+  }
+  std::sort (files.begin (), files.end ());
+  if (files.empty ()) {
+    spdlog::warn ("TextureCollage: no image found in {}", directory);
+    return;
+  }
+
+  // reuse cached collage if sources didn't change
+  auto workers = Workers (options.workers);
+  auto sources = std::vector <SourceFile> ();
+  if (!options.cache.empty ()) {
+    sources = describe (files);
+    if (loadCache (files, sources, options, workers)) {
+      return;
+    }
+  }
+  build (files, options, workers);
+  if (!options.cache.empty ()) {
+    hash (files, sources, workers);
+    saveCache (sources, options);
+  }
+}
+
+////////////////////////////////////////////////////////////
+TextureCollage::Workers::Workers (ThreadPool* workers)
+  : m_workers (workers)
+{}
+
+////////////////////////////////////////////////////////////
+TextureCollage::Workers::~Workers () = default;
+
+////////////////////////////////////////////////////////////
+ThreadPool* TextureCollage::Workers::get ()
+{
+  // calling thread take part in the work, so a pool of n - 1 threads is enough
+  if (!m_workers) {
+    m_pool = std::make_unique <ThreadPool> (std::max (1u, std::thread::hardware_concurrency ()) - 1u);
+    m_workers = m_pool.get ();
+  }
+  return m_workers;
+}
+
+////////////////////////////////////////////////////////////
+void TextureCollage::build (
+  const std::vector <fs::path>& files,
+  const CollageOptions& options,
+  Workers& workers)
+{
+  // decode images and apply mask on workers, each image is decoded independently
+  auto decoded = std::vector <TextureCollage::ImageInfo> (files.size ());
+  auto loaded = std::vector <char> (files.size (), false);
+  const auto decode = [&] (const size_t begin, const size_t end) {
+    for (auto i = begin; i < end; i++) {
+      auto& info = decoded [i];
+      if (info.image.loadFromFile (files [i])) {
+        info.name = files [i].stem ().string ();
         if (options.useMask) {
           info.image.createMaskFromColor (options.maskColor);
         }
-        // compute image surface
-        const auto size = info.image.getSize ();
-        totalSurface += size.x * size.y;
+        loaded [i] = true;
       }
     }
+  };
+  if (files.size () > 1) {
+    workers.get ()->parallelFor (files.size (), decode);
+  } else {
+    decode (0, files.size ());
+  }
+
+  // keep loaded images in files order
+  auto imagesData = std::vector <TextureCollage::ImageInfo> ();
+  imagesData.reserve (files.size ());
+  for (size_t i = 0; i < files.size (); i++) {
+    if (loaded [i]) {
+      imagesData.push_back (std::move (decoded [i]));
+    } else {
+      spdlog::warn ("TextureCollage: unable to load {}, it will be skipped", files [i].string ());
+      m_report.failed++;
+    }
+  }
+  if (imagesData.empty ()) {
+    return;
   }
 
-  // sort image size first along height, then along width
-  std::sort (std::begin (imagesData), std::end (imagesData),
+  // sort images by height then width, skyline waste less space on sorted images
+  std::stable_sort (std::begin (imagesData), std::end (imagesData),
     [] (const ImageInfo& a, const ImageInfo& b) {
       const auto sizeA = a.image.getSize ();
       const auto sizeB = b.image.getSize ();
-      return (sizeA.x * sizeA.y) > (sizeB.x * sizeB.y);
+      if (sizeA.y != sizeB.y) return sizeA.y > sizeB.y;
+      if (sizeA.x != sizeB.x) return sizeA.x > sizeB.x;
+      return a.name < b.name;
     }
   );
 
-  // compute image size as power of two large enough to hold all images surface
-  auto collageSize = sf::Vector2u { 1024u, 1024u };
-  auto textureSurface = collageSize.x * collageSize.y;
-  while (textureSurface < 1.5f*totalSurface) {
-    if (collageSize.x <= collageSize.y) {
-      collageSize.x *= 2u;
-    } else {
-      collageSize.y *= 2u;
+  // padded size of each image
+  const auto border = 2u * options.padding;
+  auto padded = std::vector <sf::Vector2u> ();
+  padded.reserve (imagesData.size ());
+  auto totalSurface = 0.0;
+  auto imagesSurface = 0.0;
+  auto maxWidth = 0u;
+  for (const auto& info : imagesData) {
+    const auto size = info.image.getSize ();
+    padded.emplace_back (size.x + border, size.y + border);
+    totalSurface += double (padded.back ().x) * padded.back ().y;
+    imagesSurface += double (size.x) * size.y;
+    maxWidth = std::max (maxWidth, padded.back ().x);
+  }
+
+  // pack with a few widths around a square and keep the smallest collage
+  auto collageSize = sf::Vector2u ();
+  auto positions = std::vector <std::optional <sf::Vector2u>> ();
+  const auto side = std::sqrt (totalSurface);
+  for (const auto factor : {1.0, 1.1, 1.25, 1.5, 2.0}) {
+    auto width = std::max (maxWidth, static_cast <uint32_t> (std::ceil (side * factor)));
+    if (options.powerOfTwo) {
+      width = nextPowerOfTwo (width);
+    }
+    auto skyline = Skyline (width);
+    auto placed = std::vector <std::optional <sf::Vector2u>> ();
+    placed.reserve (padded.size ());
+    for (const auto& size : padded) {
+      placed.push_back (skyline.insert (size));
+    }
+    auto size = sf::Vector2u (width, skyline.height ());
+    if (options.powerOfTwo) {
+      size.y = nextPowerOfTwo (size.y);
+    }
+    if (positions.empty () || uint64_t (size.x) * size.y < uint64_t (collageSize.x) * collageSize.y) {
+      collageSize = size;
+      positions = std::move (placed);
     }
-    textureSurface = collageSize.x * collageSize.y;
   }
-  m_collage.resize (collageSize, sf::Color::White); 
-  
+  m_collage.resize (collageSize, sf::Color::White);
+
   // build atlas and glue all images
-  auto position = sf::Vector2i {};
-  auto lastPos = sf::Vector2i {};
-  auto lastSize = sf::Vector2i {};
-  auto rowHeight = static_cast <int> (imagesData.front ().image.getSize ().y);
-  const auto width = static_cast <int> (collageSize.x);
-  for (const auto& info : imagesData) {
-    const auto size = sf::Vector2i (info.image.getSize ());
-    // go to next line if needed
-    if (position.x + size.x > width) {
-      // add smaller box next to the last one if it fit
-      position.x = 0;
-      position.y += rowHeight;
-      rowHeight = size.y;
-    }
-    // add image to the atlas
-    if (m_collage.copy (info.image, sf::Vector2u (position))) {
-      m_atlas.add (info.name, sf::IntRect { position, size });
-      position.x += size.x;
-      lastSize = size;
-      lastPos = position;
-      rowHeight = std::max (size.y, rowHeight);
+  for (size_t i = 0; i < imagesData.size (); i++) {
+    const auto& info = imagesData [i];
+    if (positions [i] && glue (info, *positions [i], options)) {
+      const auto position = sf::Vector2i (*positions [i]) + sf::Vector2i (options.padding, options.padding);
+      m_atlas.add (info.name, sf::IntRect { position, sf::Vector2i (info.image.getSize ()) });
+      m_report.packed++;
+    } else {
+      spdlog::warn ("TextureCollage: unable to glue {} in the collage", info.name);
+      m_report.failed++;
+    }
+  }
+
+  // report collage usage
+  m_report.size = collageSize;
+  const auto collageSurface = double (collageSize.x) * collageSize.y;
+  m_report.occupancy = collageSurface > 0.0 ? static_cast <float> (imagesSurface / collageSurface) : 0.f;
+}
+
+////////////////////////////////////////////////////////////
+bool TextureCollage::glue (
+  const ImageInfo& info,
+  const sf::Vector2u& position,
+  const CollageOptions& options)
+{
+  // copy image inside its padding
+  const auto padding = options.padding;
+  const auto origin = position + sf::Vector2u (padding, padding);
+  if (!m_collage.copy (info.image, origin)) {
+    return false;
+  }
+  const auto size = info.image.getSize ();
+  if (!options.extrude || padding == 0u || size.x == 0u || size.y == 0u) {
+    return true;
+  }
+
+  // repeat first and last rows and columns in the padding
+  const auto width = static_cast <int> (size.x);
+  const auto height = static_cast <int> (size.y);
+  for (auto p = 1u; p <= padding; p++) {
+    m_collage.copy (info.image, {origin.x, origin.y - p}, sf::IntRect ({0, 0}, {width, 1}));
+    m_collage.copy (info.image, {origin.x, origin.y + size.y - 1u + p}, sf::IntRect ({0, height - 1}, {width, 1}));
+    m_collage.copy (info.image, {origin.x - p, origin.y}, sf::IntRect ({0, 0}, {1, height}));
+    m_collage.copy (info.image, {origin.x + size.x - 1u + p, origin.y}, sf::IntRect ({width - 1, 0}, {1, height}));
+  }
+
+  // and corners pixels in the padding corners
+  const auto last = size - sf::Vector2u (1u, 1u);
+  for (auto dy = 1u; dy <= padding; dy++) {
+    for (auto dx = 1u; dx <= padding; dx++) {
+      m_collage.setPixel ({origin.x - dx, origin.y - dy}, info.image.getPixel ({0u, 0u}));
+      m_collage.setPixel ({origin.x + last.x + dx, origin.y - dy}, info.image.getPixel ({last.x, 0u}));
+      m_collage.setPixel ({origin.x - dx, origin.y + last.y + dy}, info.image.getPixel ({0u, last.y}));
+      m_collage.setPixel ({origin.x + last.x + dx, origin.y + last.y + dy}, info.image.getPixel (last));
     }
   }
+  return true;
+}
+
+////////////////////////////////////////////////////////////
+std::vector <TextureCollage::SourceFile> TextureCollage::describe (
+  const std::vector <fs::path>& files) const
+{
+  // file status is cheap, content is hashed only when status changed
+  auto sources = std::vector <SourceFile> (files.size ());
+  for (size_t i = 0; i < files.size (); i++) {
+    auto error = std::error_code ();
+    auto& source = sources [i];
+    source.name = files [i].filename ().string ();
+    source.size = fs::file_size (files [i], error);
+    source.time = fs::last_write_time (files [i], error).time_since_epoch ().count ();
+  }
+  return sources;
+}
+
+////////////////////////////////////////////////////////////
+void TextureCollage::hash (
+  const std::vector <fs::path>& files,
+  std::vector <SourceFile>& sources,
+  Workers& workers) const
+{
+  const auto hashSources = [&] (const size_t begin, const size_t end) {
+    for (auto i = begin; i < end; i++) {
+      auto& source = sources [i];
+      if (!source.hashed) {
+        source.hash = hashFile (files [i]);
+        source.hashed = true;
+      }
+    }
+  };
+  // workers are only started if more than one file must be read
+  const auto unhashed = std::count_if (std::begin (sources), std::end (sources),
+    [] (const SourceFile& source) { return !source.hashed; });
+  if (unhashed > 1) {
+    workers.get ()->parallelFor (files.size (), hashSources);
+  } else if (unhashed == 1) {
+    hashSources (0, files.size ());
+  }
+}
+
+////////////////////////////////////////////////////////////
+bool TextureCollage::loadCache (
+  const std::vector <fs::path>& files,
+  std::vector <SourceFile>& sources,
+  const CollageOptions& options,
+  Workers& workers)
+{
+  // quit if there is no cache
+  const auto manifestFile = options.cache + ".json";
+  auto input = std::ifstream (manifestFile);
+  if (!input) {
+    return false;
+  }
+  const auto manifest = json::parse (input, nullptr, false);
+  if (manifest.is_discarded ()) {
+    spdlog::warn ("TextureCollage: cache manifest {} is invalid, collage will be rebuilt", manifestFile);
+    return false;
+  }
+
+  // check that collage was built from the same images with the same options
+  try {
+    if (manifest.at ("version").get <int> () != CacheVersion || manifest.at ("options") != toJson (options)) {
+      return false;
+    }
+    const auto& cached = manifest.at ("sources");
+    if (cached.size () != sources.size ()) {
+      return false;
+    }
+    // unchanged size and time keep cached hash, other sources are hashed
+    auto touched = false;
+    for (size_t i = 0; i < sources.size (); i++) {
+      const auto& source = cached [i];
+      if (source.at ("name").get <std::string> () != sources [i].name) {
+        return false;
+      }
+      if (source.at ("size").get <uint64_t> () == sources [i].size
+        && source.at ("time").get <int64_t> () == sources [i].time) {
+        sources [i].hash = source.at ("hash").get <uint64_t> ();
+        sources [i].hashed = true;
+      } else {
+        touched = true;
+      }
+    }
+    if (touched) {
+      hash (files, sources, workers);
+      for (size_t i = 0; i < sources.size (); i++) {
+        if (cached [i].at ("hash").get <uint64_t> () != sources [i].hash) {
+          return false;
+        }
+      }
+    }
+
+    // load collage and its atlas
+    if (!m_collage.loadFromFile (options.cache + ".png")) {
+      return false;
+    }
+    m_atlas.clear ();
+    for (const auto& entry : manifest.at ("atlas").items ()) {
+      auto frames = entry.value ().get <Frames> ();
+      m_atlas.add (entry.key (), std::move (frames.texture), frames.count);
+    }
+    const auto& cachedReport = manifest.at ("report");
+    auto report = CollageReport ();
+    report.packed = cachedReport.at ("packed").get <uint32_t> ();
+    report.failed = cachedReport.at ("failed").get <uint32_t> ();
+    report.size = m_collage.getSize ();
+    report.occupancy = cachedReport.at ("occupancy").get <float> ();
+    m_report = report;
+
+    // files were touched without change, their new status avoid hashing them again
+    if (touched) {
+      saveManifest (sources, options);
+    }
+  } catch (const json::exception& error) {
+    spdlog::warn ("TextureCollage: cache manifest {} is invalid ({}), collage will be rebuilt", manifestFile, error.what ());
+    m_atlas.clear ();
+    return false;
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////
+void TextureCollage::saveCache (
+  const std::vector <SourceFile>& sources,
+  const CollageOptions& options) const
+{
+  // write image first, so that a manifest always point to a complete image
+  if (!m_collage.saveToFile (options.cache + ".png")) {
+    spdlog::warn ("TextureCollage: unable to write cache image {}.png", options.cache);
+    return;
+  }
+  saveManifest (sources, options);
+}
+
+////////////////////////////////////////////////////////////
+void TextureCollage::saveManifest (
+  const std::vector <SourceFile>& sources,
+  const CollageOptions& options) const
+{
+  // write sources, options, atlas and report
+  auto manifest = json ();
+  manifest ["version"] = CacheVersion;
+  manifest ["options"] = toJson (options);
+  manifest ["sources"] = json::array ();
+  for (const auto& source : sources) {
+    manifest ["sources"].push_back ({
+      {"name", source.name},
+      {"size", source.size},
+      {"time", source.time},
+      {"hash", source.hash}
+    });
+  }
+  manifest ["atlas"] = json::object ();
+  for (const auto& entry : m_atlas) {
+    manifest ["atlas"][entry.first] = entry.second;
+  }
+  manifest ["report"] = {
+    {"packed", m_report.packed},
+    {"failed", m_report.failed},
+    {"occupancy", m_report.occupancy}
+  };
+  saveInFile (manifest, options.cache + ".json", true);
 }
 
 } // namespace sgui
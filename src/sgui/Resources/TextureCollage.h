@@ -1,11 +1,16 @@
 #pragma once
 
+#include <memory>
 #include <string>
+#include <vector>
+#include <filesystem>
 #include <SFML/Graphics/Image.hpp>
 #include "sgui/Resources/TextureAtlas.h"
 
 namespace sgui 
 {
+class ThreadPool;
+
 /**
  * @brief Options for collage
  */
@@ -15,6 +20,21 @@ struct CollageOptions {
   // data
   bool useMask = false;                   ///< Use a mask to suppress a background color
   sf::Color maskColor = sf::Color::White; ///< Background color to be suppressed
+  uint32_t padding = 0u;                  ///< Pixels left around each image
+  bool extrude = false;                   ///< Fill padding with image border, to avoid bleeding
+  bool powerOfTwo = false;                ///< Round collage size to power of two
+  ThreadPool* workers = nullptr;          ///< Workers decoding images, a pool is started if null and work is needed
+  std::string cache = "";                 ///< Path of cache files without extension, empty to disable cache
+};
+
+/**
+ * @brief Summary of the packing of a collage
+ */
+struct CollageReport {
+  uint32_t packed = 0u;   ///< Number of images glued in the collage
+  uint32_t failed = 0u;   ///< Number of images that couldn't be loaded or glued
+  sf::Vector2u size = {}; ///< Size of the collage
+  float occupancy = 0.f;  ///< Fraction of the collage covered by images
 };
 
 /**
@@ -28,7 +48,9 @@ public:
   };
 public:
   /**
-   * @brief build a texture from a collage of all images in the directory
+   * @brief build a texture from a collage of all images in the directory. If
+   *   a cache is set and images didn't change since it was written, collage
+   *   and atlas are loaded from it instead.
    * @param directory Directory from which all images will be patched
    * @param options If a color need to be removed from images
    */
@@ -42,9 +64,67 @@ public:
    */
   TextureAtlas& atlas () { return m_atlas; }
   const TextureAtlas& atlas () const { return m_atlas; }
+  /**
+   * @brief get summary of the collage packing
+   */
+  const CollageReport& report () const { return m_report; }
+private:
+  /**
+   * size, modification time and content hash of an image file
+   */
+  struct SourceFile {
+    std::string name;
+    uint64_t size = 0u;
+    int64_t time = 0;
+    uint64_t hash = 0u;
+    bool hashed = false;
+  };
+  /**
+   * workers given in options, or a pool started at first use, so that a
+   * valid cache is loaded without starting any thread
+   */
+  class Workers {
+  public:
+    explicit Workers (ThreadPool* workers);
+    ~Workers ();
+    ThreadPool* get ();
+  private:
+    ThreadPool* m_workers = nullptr;
+    std::unique_ptr <ThreadPool> m_pool;
+  };
+  /**
+   * decode, pack and glue images in the collage
+   */
+  void build (const std::vector <std::filesystem::path>& files, const CollageOptions& options, Workers& workers);
+  /**
+   * glue image at position, with its padding filled if extruded
+   */
+  bool glue (const ImageInfo& info, const sf::Vector2u& position, const CollageOptions& options);
+  /**
+   * describe source files with their size and modification time only
+   */
+  std::vector <SourceFile> describe (const std::vector <std::filesystem::path>& files) const;
+  /**
+   * hash content of sources not hashed yet, on workers
+   */
+  void hash (const std::vector <std::filesystem::path>& files, std::vector <SourceFile>& sources, Workers& workers) const;
+  /**
+   * load collage from cache if it was built with the same sources and options.
+   *   Only sources whose size or modification time changed are hashed.
+   */
+  bool loadCache (const std::vector <std::filesystem::path>& files, std::vector <SourceFile>& sources, const CollageOptions& options, Workers& workers);
+  /**
+   * write collage, atlas and sources manifest in cache
+   */
+  void saveCache (const std::vector <SourceFile>& sources, const CollageOptions& options) const;
+  /**
+   * write sources manifest, with atlas and report of the collage
+   */
+  void saveManifest (const std::vector <SourceFile>& sources, const CollageOptions& options) const;
 private:
   sf::Image m_collage;
   TextureAtlas m_atlas;
+  CollageReport m_report;
 };
 
 } // namespace sgui
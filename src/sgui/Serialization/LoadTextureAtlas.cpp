@@ -1,4 +1,10 @@
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include <string_view>
+#include <spdlog/spdlog.h>
 #include "sgui/Serialization/LoadTextureAtlas.h"
+#include "sgui/Resources/MappedTextureAtlas.h"
 #include "sgui/Serialization/LoadJson.h"
 #include "sgui/Serialization/SerializeGUI.h"
 
@@ -38,4 +44,70 @@ void saveInFile (
   saveInFile (out, file, compact);
 }
 
+/////////////////////////////////////////////////
+// binary TextureAtlas
+/////////////////////////////////////////////////
+bool saveInBinaryFile (
+  const TextureAtlas& atlas,
+  const std::string& file)
+{
+  using Header = MappedTextureAtlas::Header;
+  using Entry = MappedTextureAtlas::Entry;
+  // sort entries by name, so that they can be searched in place
+  auto sorted = std::vector <std::pair <std::string_view, const Frames*>> ();
+  for (const auto& entry : atlas) {
+    sorted.emplace_back (entry.first, &entry.second);
+  }
+  std::sort (std::begin (sorted), std::end (sorted));
+
+  // build entries and names table
+  auto header = Header ();
+  auto names = std::string ();
+  auto entries = std::vector <Entry> ();
+  entries.reserve (sorted.size ());
+  for (const auto& [name, frames] : sorted) {
+    auto entry = Entry ();
+    entry.nameOffset = static_cast<uint32_t> (names.size ());
+    entry.nameSize = static_cast<uint32_t> (name.size ());
+    entry.left = frames->texture.position.x;
+    entry.top = frames->texture.position.y;
+    entry.width = frames->texture.size.x;
+    entry.height = frames->texture.size.y;
+    entry.count = frames->count;
+    header.texturesCount += frames->count;
+    names.append (name);
+    entries.push_back (entry);
+  }
+  header.version = MappedTextureAtlas::Version;
+  header.entriesCount = static_cast<uint32_t> (entries.size ());
+  header.namesSize = static_cast<uint32_t> (names.size ());
+
+  // write everything in one go
+  auto out = std::ofstream (file, std::ios::binary);
+  if (!out) {
+    spdlog::error ("saveInBinaryFile: unable to open {}", file);
+    return false;
+  }
+  out.write (reinterpret_cast<const char*> (&header), sizeof (Header));
+  out.write (reinterpret_cast<const char*> (entries.data ()), entries.size () * sizeof (Entry));
+  out.write (names.data (), names.size ());
+  if (!out) {
+    spdlog::error ("saveInBinaryFile: unable to write {}", file);
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool convertTextureAtlas (
+  const std::string& jsonFile,
+  const std::string& binaryFile)
+{
+  auto atlas = TextureAtlas ();
+  if (!loadFromFile (atlas, jsonFile)) {
+    return false;
+  }
+  return saveInBinaryFile (atlas, binaryFile);
+}
+
 } // namespace sgui
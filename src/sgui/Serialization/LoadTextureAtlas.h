@@ -20,4 +20,18 @@ NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT (Frames, count, texture);
 bool loadFromFile (TextureAtlas& atlas, const std::string& file);
 void saveInFile (const TextureAtlas& atlas, const std::string& file, const bool compact = false);
 
+/**
+ * @brief save sprite atlas in the binary format read by MappedTextureAtlas
+ * @return `true` if the file was written
+ */
+bool saveInBinaryFile (const TextureAtlas& atlas, const std::string& file);
+
+/**
+ * @brief convert a json sprite atlas into a binary one
+ * @param jsonFile Atlas to convert
+ * @param binaryFile File in which the binary atlas is written
+ * @return `true` if the conversion was successful
+ */
+bool convertTextureAtlas (const std::string& jsonFile, const std::string& binaryFile);
+
 } // namespace sgui
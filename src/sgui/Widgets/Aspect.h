@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include "sgui/Widgets/Widgets.h"
 #include "sgui/Widgets/ItemStates.h"
 
@@ -30,4 +31,33 @@ struct WidgetAspect
   ItemState state = ItemState::None; ///< To force a specific state
 };
 
+/**
+ * @brief Non-owning view of a WidgetAspect, used by widgets. Its image must
+ *   live until the widget call returns.
+ */
+struct WidgetAspectView
+{
+  WidgetAspectView () = default;
+  /**
+   * @brief Cheap conversion from an owning aspect
+   */
+  WidgetAspectView (const WidgetAspect& a)
+    : image (a.image), widget (a.widget), slices (a.slices), state (a.state) {}
+  /**
+   * @brief Constructor for widgets with default texture name
+   */
+  WidgetAspectView (const Widget w, const Slices s = Slices::Default, const ItemState is = ItemState::None)
+    : widget (w), slices (s), state (is) {}
+  /**
+   * @brief Constructor for widgets with custom texture name
+   */
+  WidgetAspectView (std::string_view img, const Slices s = Slices::Default, const ItemState is = ItemState::None)
+    : image (img), slices (s), state (is) {}
+  // data
+  std::string_view image = {};       ///< Custom widget texture, see WidgetAspect
+  Widget widget = Widget::None;      ///< Change default widget type
+  Slices slices = Slices::Default;   ///< Change default widget slicing
+  ItemState state = ItemState::None; ///< To force a specific state
+};
+
 } // namespace sgui
@@ -1,5 +1,11 @@
 #pragma once
 
+#include <memory>
+#include <string>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+#include "sgui/Core/FunctionRef.h"
 #include "sgui/Widgets/Constraints.h"
 #include "sgui/Widgets/Aspect.h"
 
@@ -67,8 +73,128 @@ struct WidgetOptions
   WidgetAspect aspect = {};          ///< To control widget aspect
 };
 
+/////////////////////////////////////////////////
+/**
+ * @brief Non-owning view of a tooltip. The gui copies it in an owning Tooltip at
+ *   each frame its widget is hovered, so the viewed tooltip or callable only has
+ *   to live until the widget call returns.
+ */
+struct TooltipView
+{
+  TooltipView () = default;
+  /**
+   * @brief Cheap conversion from an owning tooltip
+   */
+  TooltipView (const Tooltip& t)
+    : locked (t.locked), active (t.active), display (t.display), owner (&t) {}
+  /**
+   * @brief Reference a callable, it is only copied if its widget is hovered
+   */
+  template <typename Callable, typename = std::enable_if_t<
+    !std::is_same_v<std::decay_t<Callable>, Tooltip>
+    && std::is_invocable_r_v<void, Callable>>>
+  TooltipView (Callable&& d, const bool l = false, const bool a = true)
+    : locked (l), active (a), display (d), mCopy (&copyCallable <Callable>)
+  {
+    if constexpr (!std::is_function_v<std::remove_reference_t<Callable>>) {
+      mCallable = std::addressof (d);
+    }
+  }
+  /**
+   * @brief Copy viewed tooltip and its callable in an owning tooltip, its
+   *   parent is left untouched
+   */
+  void copyTo (Tooltip& tooltip) const
+  {
+    if (owner) {
+      tooltip.locked = owner->locked;
+      tooltip.active = owner->active;
+      tooltip.display = owner->display;
+      return;
+    }
+    tooltip.locked = locked;
+    tooltip.active = active;
+    tooltip.display = nullptr;
+    if (display && mCopy) {
+      mCopy (*this, tooltip.display);
+    }
+  }
+  // data
+  bool locked = false;                ///< is tooltip locked ?
+  bool active = false;                ///< is tooltip active ?
+  FunctionRef <void (void)> display;  ///< function called to display tooltip
+  const Tooltip* owner = nullptr;     ///< owning tooltip, if any
+private:
+  template <typename Callable>
+  static void copyCallable (const TooltipView& view, std::function <void (void)>& display)
+  {
+    using Type = std::remove_reference_t<Callable>;
+    // a function is kept by pointer in the reference
+    if constexpr (std::is_function_v<Type>) {
+      display = view.display;
+    } else {
+      display = *static_cast<const Type*> (view.mCallable);
+    }
+  }
+  const void* mCallable = nullptr;
+  void (*mCopy) (const TooltipView&, std::function <void (void)>&) = nullptr;
+};
+
+/////////////////////////////////////////////////
+/**
+ * @brief Non-owning view of widget options, taken by every widget. It is as cheap
+ *   to build as its fields, so calls with default options don't allocate.
+ *   Viewed strings must live until the widget call returns.
+ */
+struct WidgetOptionsView
+{
+  WidgetOptionsView () = default;
+  /**
+   * @brief Cheap conversion from owning options
+   */
+  WidgetOptionsView (const WidgetOptions& o)
+    : horizontal (o.horizontal), size (o.size), displacement (o.displacement),
+      description (o.description), tooltip (o.tooltip), aspect (o.aspect) {}
+  /**
+   * @brief With a description, overloaded so that literals and strings are not ambiguous
+   */
+  WidgetOptionsView (std::string_view des, const TooltipView& t = {}, const sf::Vector2f& d = {})
+    : displacement (d), description (des), tooltip (t) {}
+  WidgetOptionsView (const std::string& des, const TooltipView& t = {}, const sf::Vector2f& d = {})
+    : displacement (d), description (des), tooltip (t) {}
+  WidgetOptionsView (const char* des, const TooltipView& t = {}, const sf::Vector2f& d = {})
+    : displacement (d), description (des), tooltip (t) {}
+  /**
+   * @brief When only a tooltip is needed
+   */
+  WidgetOptionsView (const TooltipView& inf) : tooltip (inf) {}
+  WidgetOptionsView (const Tooltip& inf) : tooltip (inf) {}
+  /**
+   * @brief When only the relative displacement is needed
+   */
+  WidgetOptionsView (const sf::Vector2f disp) : displacement (disp) {}
+  /**
+   * @brief To control widget appearance
+   */
+  WidgetOptionsView (const WidgetAspectView& a) : aspect (a) {}
+  /**
+   * @brief From an owning aspect, as a template so that braced aspects are
+   *   only read as views
+   */
+  template <typename Aspect, typename = std::enable_if_t<std::is_same_v<Aspect, WidgetAspect>>>
+  WidgetOptionsView (const Aspect& a) : aspect (a) {}
+  // data
+  bool horizontal = false;           ///< Is widget horizontal or vertical ?
+  sf::Vector2f size = { 6.f, 1.f };  ///< For slider and progress bar
+  sf::Vector2f displacement = {};    ///< To override automatic position
+  std::string_view description = {}; ///< Widget description
+  TooltipView tooltip = {};          ///< Tooltip specification
+  WidgetAspectView aspect = {};      ///< To control widget aspect
+};
+
 /**
- * @brief Store text options : boxSize, centered, type, etc.
+ * @brief Store text options : boxSize, centered, type, etc. It doesn't own
+ *   any memory, so widgets take it as is.
  */
 struct TextOptions
 {
@@ -3,4 +3,5 @@
 #include "sgui/Gui.h"
 #include "sgui/DefaultFiles.h"
 #include "sgui/Resources/Layout.h"
+#include "sgui/Resources/DefaultResources.h"
 #include "sgui/Resources/IconsFontAwesome7.h"
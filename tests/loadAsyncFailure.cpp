@@ -0,0 +1,33 @@
+#include <cstdlib>
+#include <iostream>
+#include <sgui/Core/ThreadPool.h>
+#include <sgui/Resources/Layout.h>
+#include <sgui/Resources/ResourcesHolder.h>
+
+/**
+ * An asynchronous load of a missing layout file throws a json parse error on
+ * a worker. It must end as a failed load, and not stay pending forever.
+ */
+int main()
+{
+  auto pool = sgui::ThreadPool (1u);
+  auto layouts = sgui::LayoutHolder ();
+  const auto handle = layouts.loadAsync (pool, "missing", "missing/layout.json");
+  handle.wait ();
+
+  auto success = true;
+  if (handle.status () != sgui::LoadStatus::Failed) {
+    std::cerr << "decoding of a missing file didn't fail" << std::endl;
+    success = false;
+  }
+  layouts.finalize ();
+  if (!handle.isDone () || layouts.isLoading ("missing")) {
+    std::cerr << "failed load is still pending after finalize" << std::endl;
+    success = false;
+  }
+  if (layouts.statistics ().failed != 1u) {
+    std::cerr << "failed load wasn't counted" << std::endl;
+    success = false;
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,48 @@
+#include <vector>
+#include <string>
+#include <filesystem>
+#include <spdlog/spdlog.h>
+#include <sgui/Resources/AssetBundle.h>
+#include <sgui/Serialization/LoadTextureAtlas.h>
+
+namespace fs = std::filesystem;
+
+/**
+ * Pack files in a bundle, assets are named after their file name.
+ * Json files are texture atlases, they are converted in binary and
+ * stored as <name>.sgta
+ */
+int main (int argc, char* argv [])
+{
+  if (argc < 3) {
+    spdlog::error ("usage: {} <bundle> <files>...", argv [0]);
+    return 1;
+  }
+  const auto bundle = std::string (argv [1]);
+  auto converted = std::vector <std::string> ();
+  auto assets = std::vector <std::pair <std::string, std::string>> ();
+  for (auto arg = 2; arg < argc; arg++) {
+    const auto file = fs::path (argv [arg]);
+    if (file.extension () != ".json") {
+      assets.emplace_back (file.filename ().string (), file.string ());
+      continue;
+    }
+    // convert atlas next to the bundle
+    const auto name = file.stem ().string () + ".sgta";
+    const auto binary = (fs::path (bundle).parent_path () / name).string ();
+    if (!sgui::convertTextureAtlas (file.string (), binary)) {
+      spdlog::error ("unable to convert atlas {}", file.string ());
+      return 1;
+    }
+    converted.push_back (binary);
+    assets.emplace_back (name, binary);
+  }
+
+  // pack and clean converted files
+  const auto success = sgui::saveInBundle (assets, bundle);
+  for (const auto& file : converted) {
+    auto error = std::error_code ();
+    fs::remove (file, error);
+  }
+  return success ? 0 : 1;
+}